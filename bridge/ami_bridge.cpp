@@ -1,34 +1,29 @@
 #include "ami_bridge.h"
 #include "data_store.h"
+#include "bar_cache.h"
 #include "api_client.h"
+#include "circuit_breaker.h"
 #include "ws_client.h"
 #include "ownership_fetcher.h"
 #include "FinancialFetcher.h"
 #include "ritel_fetcher.h"
+#include "symbol_table.h"
+#include "config.h"
+#include "gap_planner.h"
+#include "civil_date.h"
+#include "refresh_notifier.h"
 #include <windows.h>
+#include <algorithm>
 #include <vector>
 #include <chrono>
 #include <string>
 #include <memory>
-#include <thread>
-#include <mutex>
-#include <map>
 #include <atomic>
-#include <set>
-#include <condition_variable>
+#include <mutex>
+#include <deque>
 
 extern std::shared_ptr<WsClient> g_wsClient;
 extern HWND g_hAmiBrokerWnd;
-extern std::atomic<bool> g_bWorkerThreadRun;
-
-static std::mutex g_fetchMtx;
-static std::map<std::string, bool> g_isFetching;
-static std::mutex g_dataStoreMtx;
-
-// --- MUTEX & CV Definition (.h)
-std::mutex g_fetchQueueMtx;
-std::condition_variable g_fetchQueueCV;
-static std::map<std::string, FetchTask> g_fetchQueue;
 
 static void LogBridge(const std::string& msg) {
   SYSTEMTIME t;
@@ -38,313 +33,523 @@ static void LogBridge(const std::string& msg) {
   OutputDebugStringA((std::string(buf) + "[Bridge] " + msg + "\n").c_str());
 }
 
-bool QueueFetchTask(FetchTask task) {
-  std::string task_key;
+// Label untuk log saja (string dibangun hanya saat logging)
+static std::string TaskLabel(const FetchTask& task) {
+  const std::string& sym = SymbolTable::instance().name(task.symbolId);
+  switch (task.type) {
+    case FetchTaskType::GET_CANDLES:          return "CANDLES_" + sym;
+    case FetchTaskType::GET_OWNERSHIP_INDIV:  return "OWN_INDIV_" + sym;
+    case FetchTaskType::GET_OWNERSHIP_CORP:   return "OWN_CORP_" + sym;
+    case FetchTaskType::GET_FINANCIALS:       return "FINANCIALS_" + sym;
+    case FetchTaskType::GET_RITEL_FLOW:       return "RITEL_" + sym;
+    case FetchTaskType::GET_BROKER_FLOW:      return "BROKER_" + SymbolTable::instance().name(task.paramId) + "_" + sym;
+  }
+  return sym;
+}
+
+bool QueueFetchTask(FetchTask task, std::shared_future<bool>* outFuture) {
+  // Intern sekali di sini kalau pemanggil belum isi ID-nya
+  SymbolTable& table = SymbolTable::instance();
+  if (task.symbolId == kNoSymbol) task.symbolId = table.intern(task.symbol);
+  if (task.paramId == kNoSymbol && !task.extra_param.empty()) task.paramId = table.intern(task.extra_param);
+  if (task.symbolId == kNoSymbol) return false;   // Tabel simbol penuh (outFuture tidak diisi)
+  if (task.symbol.empty()) task.symbol = table.name(task.symbolId);
+
+  uint64_t task_key = TaskKeyOf(task);
+  std::string label = TaskLabel(task);
+
+  // Single-flight: key yang sama (antri / jalan) berbagi satu future
+  if (!FetchPool::instance().submit(task_key, std::move(task), outFuture)) {
+    return false; // Udah antri / ada yang ngerjain
+  }
+  LogBridge("Queued Task: " + label);
+  return true;
+}
+
+static const CacheTtlSetting& TtlFor(FetchEndpoint ep) {
+  static const CacheTtlSetting ttls[] = {
+    Config::getInstance().getTtlHistorical(),
+    Config::getInstance().getTtlOwnership(),
+    Config::getInstance().getTtlFinancials(),
+    Config::getInstance().getTtlRitelFlow(),
+  };
+  return ttls[static_cast<int>(ep)];
+}
+
+bool QueueExtraDataFetch(FetchTask task, bool hasData, std::shared_future<bool>* outFuture) {
+  if (task.symbolId != kNoSymbol) {
+    auto flight = TaskRegistry::instance().find(TaskKeyOf(task));
+    long long age = flight ? flight->ageMs() : -1;
+    if (age >= 0 && flight->state() != FlightState::CANCELLED) {
+      // Status terakhir: DONE + ada data = fresh, DONE + kosong = empty, FAILED = failed
+      const CacheTtlSetting& ttl = TtlFor(EndpointOf(task.type));
+      int ttlSec = flight->state() == FlightState::FAILED ? ttl.failedSec
+                 : hasData ? ttl.freshSec : ttl.emptySec;
+      if (age < ttlSec * 1000LL) return false;
+    }
+  }
+  if (hasData) task.priority = FetchPriority::BACKGROUND;   // Stale-while-revalidate
+  return QueueFetchTask(std::move(task), outFuture);
+}
+
+inline void LogIfDebug(const std::string& msg) {
+  #ifdef _DEBUG
+    LogBridge(msg);
+  #endif
+}
+
+// ---- Token chart: LRU beberapa simbol chart terakhir (layout multi-chart).
+// Simbol yang tergeser keluar dibatalkan, jadi ganti chart cepat tidak
+// menyisakan antrian fetch di depan chart yang sedang dilihat.
+static CancelToken ChartToken(SymbolId symbolId) {
+  static std::mutex mtx;
+  static std::deque<std::pair<SymbolId, CancelToken>> recent;    // Depan = paling baru
+  const size_t kRecentCharts = 4;
+
+  std::lock_guard<std::mutex> lock(mtx);
+  for (auto it = recent.begin(); it != recent.end(); ++it) {
+    if (it->first == symbolId) {
+      CancelToken token = it->second;
+      recent.erase(it);
+      recent.emplace_front(symbolId, token);
+      return token;
+    }
+  }
+
+  recent.emplace_front(symbolId, MakeCancelToken());
+  if (recent.size() > kRecentCharts) {
+    recent.back().second->cancelled = true;
+    LogIfDebug("Superseded chart load: " + SymbolTable::instance().name(recent.back().first));
+    recent.pop_back();
+  }
+  return recent.front().second;
+}
+
+// ---- Tebak asal permintaan candle yang harus menunggu fetch: chart (interaktif)
+// atau scan/backfill. Scan/explore memicu banyak miss simbol berbeda dalam waktu
+// singkat, sedangkan ganti chart cuma satu-dua miss per detik.
+// Scan dapat satu token per sesi. Burst scan baru setelah jeda = sesi baru, dan
+// sisa antrian sesi lama (scan selesai / di-abort) dibatalkan. Plugin API tidak
+// memberi tahu abort, jadi sesi berikutnya yang menandai sesi lama basi.
+struct CandleRequester {
+  FetchPriority priority;
+  CancelToken cancel;
+};
+
+static CandleRequester ClassifyCandleRequest(SymbolId symbolId) {
+  static std::mutex mtx;
+  static std::deque<std::chrono::steady_clock::time_point> recentMisses;
+  static CancelToken scanToken;
+  static std::chrono::steady_clock::time_point lastScanMiss;
+  const size_t kScanMissesPerSecond = 3;
+  const auto kScanIdle = std::chrono::seconds(5);
+
+  auto now = std::chrono::steady_clock::now();
+  {
+    std::lock_guard<std::mutex> lock(mtx);
+    while (!recentMisses.empty() && now - recentMisses.front() > std::chrono::seconds(1)) {
+      recentMisses.pop_front();
+    }
+    bool isScan = recentMisses.size() >= kScanMissesPerSecond;
+    recentMisses.push_back(now);
+
+    if (isScan) {
+      if (!scanToken || now - lastScanMiss > kScanIdle) {
+        if (scanToken) {
+          scanToken->cancelled = true;
+          LogBridge("Scan session " + std::to_string(scanToken->generation) + " superseded, dropping its queued fetches");
+        }
+        scanToken = MakeCancelToken();
+      }
+      lastScanMiss = now;
+      return { FetchPriority::SCAN, scanToken };
+    }
+  }
+  return { FetchPriority::INTERACTIVE, ChartToken(symbolId) };
+}
 
-  // Bikin Kunci Unik
+// Status "sedang fetching" dilacak TaskRegistry pakai TaskKey yang sama.
+// Satu panggilan = satu rentang dari GapPlanner. Return false kalau API tidak
+// mengembalikan bar (gagal / kosong).
+bool fetchAndCache(SymbolId symbolId, const std::string& from_date, const std::string& to_date) {
+  const std::string& symbol = SymbolTable::instance().name(symbolId);
+  LogIfDebug("Async fetch START for: " + symbol + " (" + from_date + " .. " + to_date + ")");
+  // Sudah packed Quotation dari parser, bukan dikonversi tiap GetQuotesEx
+  std::vector<Quotation> new_bars = fetchHistorical(symbol, from_date, to_date);
+  LogIfDebug("Async fetch finished. Got " + std::to_string(new_bars.size()) + " bars.");
+
+  // Store hanya berisi bar dari disk cache + hasil fetch; bar milik AmiBroker
+  // tetap di pQuotes dan digabung saat copy-out (MergeBarsInPlace).
+  gDataStore.mergeHistorical(symbolId, new_bars);
+
+  // Persist ke disk (hanya bar historis, live bar virtual tidak ikut tersimpan).
+  // Snapshot diambil di dalam lock per simbol: dua rentang yang selesai hampir
+  // bersamaan tidak bisa menulis snapshot yang lebih tua paling akhir.
+  if (!new_bars.empty() && BarCache::enabled()) {
+    static std::mutex s_saveMtx[16];
+    std::lock_guard<std::mutex> lock(s_saveMtx[symbolId % 16]);
+    if (auto series = gDataStore.getHistorical(symbolId)) {
+      BarCache::save(symbol, series->bars);
+    }
+  }
+
+  LogIfDebug("Async fetch COMPLETE for: " + symbol);
+  return !new_bars.empty();
+}
+
+// ---- Dijalankan oleh worker pool (bisa beberapa thread sekaligus).
+// Tugas dengan key sama tidak pernah jalan paralel: pool yang menjamin.
+static bool RunFetchTask(FetchTask& task) {
+  bool ok = false;
+
+  // --- DISPATCHER UTAMA WORKER ---
   switch (task.type) {
     case FetchTaskType::GET_CANDLES:
-      task_key = "CANDLES_" + task.symbol;
+      LogBridge("Worker processing CANDLES: " + task.symbol);
+      ok = fetchAndCache(task.symbolId, task.from_date, task.to_date);
       break;
+
     case FetchTaskType::GET_OWNERSHIP_INDIV:
-      task_key = "OWN_INDIV_" + task.symbol;
+      LogBridge("Worker processing OWN_INDIV: " + task.symbol);
+      ok = OwnershipFetcher::fetch(task.symbolId, "Individual");
       break;
+
     case FetchTaskType::GET_OWNERSHIP_CORP:
-      task_key = "OWN_CORP_" + task.symbol;
+      LogBridge("Worker processing OWN_CORP: " + task.symbol);
+      ok = OwnershipFetcher::fetch(task.symbolId, "Perusahaan");
       break;
+
     case FetchTaskType::GET_FINANCIALS:
-      task_key = "FINANCIALS_" + task.symbol;
+      LogBridge("Worker processing FINANCIALS: " + task.symbol);
+      ok = FinancialFetcher::fetch(task.symbolId);
       break;
+
     case FetchTaskType::GET_RITEL_FLOW:
-      task_key = "RITEL_" + task.symbol;
+      LogBridge("Worker processing RITEL_FLOW: " + task.symbol);
+      ok = RitelFetcher::fetch(task.symbolId);
       break;
+
     case FetchTaskType::GET_BROKER_FLOW:
-      task_key = "BROKER_" + task.extra_param + "_" + task.symbol;  // Buat key unik biar nggak tabrakan antrian
+      LogBridge("Worker processing BROKER_FLOW (" + SymbolTable::instance().name(task.paramId) + "): " + task.symbol);
+      ok = RitelFetcher::fetch(task.symbolId, task.paramId);   // Panggil fetcher pakai parameter broker
       break;
   }
 
-  if (task_key.empty()) return false;
+  // Kasih tau AmiBroker buat refresh (penting!)
+  RefreshNotifier::instance().signal(task.symbolId);
+  return ok;
+}
 
-  // Cek g_isFetching (Mutex g_fetchMtx)
-  {
-    std::lock_guard<std::mutex> lock(g_fetchMtx);
-    if (g_isFetching.count(task_key)) {
-        return false; // Udah ada yang ngerjain
-    }
-  }
+// ---- Circuit breaker terbuka: tugas antri untuk endpoint itu dibuang (FAILED)
+static bool ShedEndpoint(FetchEndpoint endpoint) {
+  static const RateFamily kFamilies[] = {
+    RateFamily::HISTORICAL, RateFamily::OWNERSHIP, RateFamily::FINANCIALS, RateFamily::RITELFLOW,
+  };
+  return CircuitBreaker::instance().shedding(kFamilies[static_cast<int>(endpoint)]);
+}
 
-  // Cek g_fetchQueue (Mutex g_fetchQueueMtx)
-  {
-    std::lock_guard<std::mutex> lock(g_fetchQueueMtx);
-    if (g_fetchQueue.count(task_key)) {
-      return false; // Udah ada di antrian
-    }
-    
-    // Kalo aman, baru masukin antrian
-    g_fetchQueue[task_key] = std::move(task);
-    LogBridge("Queued Task: " + task_key);
-    g_fetchQueueCV.notify_one();
-  }
-  return true;
+void StartFetchWorkers() {
+  const Config& cfg = Config::getInstance();
+  FetchPoolConfig poolCfg;
+  poolCfg.workers = cfg.getFetchWorkers();
+  poolCfg.endpointLimit[static_cast<int>(FetchEndpoint::HISTORICAL)] = cfg.getFetchLimitHistorical();
+  poolCfg.endpointLimit[static_cast<int>(FetchEndpoint::OWNERSHIP)]  = cfg.getFetchLimitOwnership();
+  poolCfg.endpointLimit[static_cast<int>(FetchEndpoint::FINANCIALS)] = cfg.getFetchLimitFinancials();
+  poolCfg.endpointLimit[static_cast<int>(FetchEndpoint::RITELFLOW)]  = cfg.getFetchLimitRitelFlow();
+  poolCfg.shed = ShedEndpoint;
+  FetchPool::instance().start(poolCfg, RunFetchTask);
 }
 
-inline void LogIfDebug(const std::string& msg) {
-  #ifdef _DEBUG
-    LogBridge(msg);
-  #endif
+void StopFetchWorkers() {
+  FetchPool::instance().stop();
 }
 
-std::string AmiDateToString(const PackedDate& pd) {
-  char buffer[12];
-  sprintf_s(buffer, sizeof(buffer), "%04d-%02d-%02d", pd.Year, pd.Month, pd.Day);
-  return std::string(buffer);
+// ---- Epoch day -> "YYYY-MM-DD" untuk parameter API
+static std::string DaysToDateString(int32_t days) {
+  char buf[11];
+  CivilDate::FormatIsoDate(days, buf);
+  return buf;
 }
 
-void fetchAndCache(std::string symbol, std::string from_date, std::string to_date, std::vector<Candle> existing_candles) {
-  LogIfDebug("Async fetch START for: " + symbol);
-  {
-    // Tandai sebagai "sedang fetching"
-    std::lock_guard<std::mutex> lock(g_fetchMtx);
-    g_isFetching[symbol] = true;
+// ---- Lubang tengah yang diantrikan per simbol. Key ekor selalu MakeCandleKey(symbol),
+// key lubang tergantung rangeDay-nya, jadi dicatat di sini supaya status "sedang
+// fetching" satu simbol mencakup semua rentangnya. Counter atomik per simbol
+// membuat cek di jalur GetQuotesEx tetap tanpa lock kalau tidak ada lubang.
+static std::mutex g_interiorMtx;
+static IdMap<std::vector<int32_t>> g_interiorRanges;                 // Key: SymbolId
+static std::atomic<uint8_t> g_interiorCount[SymbolTable::kCapacity];  // Ukuran g_interiorRanges[id]
+
+static void NoteInteriorRange(SymbolId symbolId, int32_t rangeDay) {
+  std::lock_guard<std::mutex> lock(g_interiorMtx);
+  std::vector<int32_t>& days = g_interiorRanges[symbolId];
+  if (std::find(days.begin(), days.end(), rangeDay) != days.end()) return;
+  if (days.size() >= GapPlanner::kMaxRanges) return;    // Tidak dilacak, hanya status busy-nya yang hilang
+  days.push_back(rangeDay);
+  g_interiorCount[symbolId].store(static_cast<uint8_t>(days.size()), std::memory_order_release);
+}
+
+// Key candle simbol yang masih antri / jalan: ekor + lubang tengah. Lubang yang
+// sudah selesai dibuang dari catatan. keys minimal kMaxRanges + 1 elemen.
+static size_t CandleKeysInFlight(SymbolId symbolId, uint64_t* keys) {
+  TaskRegistry& registry = TaskRegistry::instance();
+  size_t n = 0;
+  uint64_t tail = MakeCandleKey(symbolId);
+  if (registry.inFlight(tail)) keys[n++] = tail;
+
+  if (g_interiorCount[symbolId].load(std::memory_order_acquire) == 0) return n;
+  std::lock_guard<std::mutex> lock(g_interiorMtx);
+  std::vector<int32_t>* days = g_interiorRanges.find(symbolId);
+  if (!days) return n;
+  for (size_t i = 0; i < days->size();) {
+    uint64_t key = MakeCandleKey(symbolId, (*days)[i]);
+    if (registry.inFlight(key)) {
+      keys[n++] = key;
+      i++;
+    } else {
+      (*days)[i] = days->back();
+      days->pop_back();
+    }
   }
-  std::vector<Candle> new_candles = fetchHistorical(symbol, from_date, to_date);
-  LogIfDebug("Async fetch finished. Got " + std::to_string(new_candles.size()) + " bars.");
+  g_interiorCount[symbolId].store(static_cast<uint8_t>(days->size()), std::memory_order_release);
+  if (days->empty()) g_interiorRanges.erase(symbolId);
+  return n;
+}
 
-  // Merge existing preload candles from AmiBroker (jika tersedia)
-  if (!existing_candles.empty()) {
-    gDataStore.mergeHistorical(symbol, existing_candles);
+// ---- Akses pertama simbol di sesi ini: rencanakan & antrikan rentang yang kurang.
+// bars[0..n) = pQuotes yang sudah digabung dengan disk cache. futures (opsional)
+// diisi future tiap rentang, untuk pemanggil yang mau menunggu (warmup).
+static void QueueMissingRanges(SymbolId symbolId, const Quotation* bars, int n, bool liveCoversToday,
+                               FetchPriority priority, const CancelToken& cancel,
+                               std::vector<std::shared_future<bool>>* futures) {
+  FetchRange ranges[GapPlanner::kMaxRanges];
+  int32_t today = EodDateToDays(TodayEodDate());
+  size_t count = GapPlanner::plan(bars, static_cast<size_t>(n), today, !liveCoversToday, ranges);
+
+  if (count == 0) {
+    LogIfDebug("Up to date, no fetch: " + SymbolTable::instance().name(symbolId));
+    return;
   }
 
-  // Merge new candles dari API
-  if (!new_candles.empty()) {
-    gDataStore.mergeHistorical(symbol, new_candles);
+  for (size_t r = 0; r < count; r++) {
+    FetchTask task;
+    task.type = FetchTaskType::GET_CANDLES;
+    task.priority = priority;
+    task.symbolId = symbolId;
+    task.cancel = cancel;
+    // Ekor = satu key per simbol (bisa di-promote & dedupe dengan revalidasi);
+    // lubang di tengah dibedakan lewat epoch day awal rentang.
+    task.rangeDay = ranges[r].trailing ? kTrailingRange : ranges[r].fromDay;
+    if (!ranges[r].trailing) NoteInteriorRange(symbolId, task.rangeDay);
+    task.from_date = DaysToDateString(ranges[r].fromDay);
+    task.to_date = DaysToDateString(ranges[r].toDay);
+
+    std::shared_future<bool> future;
+    QueueFetchTask(std::move(task), &future);
+    if (futures && future.valid()) futures->push_back(future);
   }
+}
 
-  // Jika semua kosong, buat empty cache supaya mark as checked
-  if (existing_candles.empty() && new_candles.empty()) {
-    gDataStore.setHistorical(symbol, {});
+// ---- Stale-while-revalidate: seri di store lebih tua dari TTL fresh. Pemanggil
+// tetap dapat bar lama; ekor seri (beberapa hari terakhir, untuk koreksi +
+// pergantian hari) di-fetch ulang di kelas BACKGROUND. Fetch yang barusan gagal
+// ditahan sampai TTL failed lewat, jadi tidak mengulang tiap GetQuotesEx.
+// bars[0..n) = pQuotes yang sudah digabung, untuk merencanakan ulang load yang
+// dibatalkan (chart tergeser / sesi scan lama) saat simbolnya diminta lagi.
+static void QueueRevalidate(SymbolId symbolId, const BarSeries& series, uint64_t candleKey,
+                            const Quotation* bars, int n, bool liveCoversToday) {
+  const CacheTtlSetting& ttl = TtlFor(FetchEndpoint::HISTORICAL);
+  auto flight = TaskRegistry::instance().find(candleKey);
+  if (flight && flight->inFlight()) return;
+
+  if (flight && flight->state() == FlightState::CANCELLED) {
+    FetchRange ranges[GapPlanner::kMaxRanges];
+    int32_t today = EodDateToDays(TodayEodDate());
+    if (GapPlanner::plan(bars, static_cast<size_t>(n), today, !liveCoversToday, ranges) == 0) return;
+
+    CandleRequester requester = ClassifyCandleRequest(symbolId);
+    QueueMissingRanges(symbolId, bars, n, liveCoversToday, requester.priority, requester.cancel, nullptr);
+    return;
   }
 
-  {
-    std::lock_guard<std::mutex> lock(g_fetchMtx);
-    g_isFetching.erase(symbol);   // Hapus tanda "sedang fetching"
+  if (flight && flight->state() == FlightState::FAILED) {
+    // Fetch terakhir gagal (backend down / breaker shed): ulangi setelah TTL failed,
+    // walaupun seri dari disk cache masih terhitung fresh
+    if (flight->ageMs() < ttl.failedSec * 1000LL) return;
+  } else {
+    if (ttl.freshSec <= 0) return;    // 0 = revalidasi dimatikan
+    auto now = std::chrono::duration_cast<std::chrono::milliseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count();
+    if (now - series.fetchedAtMs < ttl.freshSec * 1000LL) return;
   }
 
-  if (g_hAmiBrokerWnd) PostMessage(g_hAmiBrokerWnd, WM_USER_STREAMING_UPDATE, 0, 0);
-  LogIfDebug("Async fetch COMPLETE for: " + symbol);
+  const int32_t kRevalidateDays = 7;
+  int32_t today = EodDateToDays(TodayEodDate());
+  int32_t from = series.bars.empty() ? today - GapPlanner::kDefaultLookbackDays
+                                     : EodDateToDays(series.bars.back().DateTime.Date) - kRevalidateDays;
+
+  FetchTask task;
+  task.type = FetchTaskType::GET_CANDLES;
+  task.priority = FetchPriority::BACKGROUND;
+  task.symbolId = symbolId;
+  task.rangeDay = kTrailingRange;   // Key sama dengan ekor (candleKey): dedupe dengan fetch biasa
+  task.from_date = DaysToDateString(std::min(from, today));
+  task.to_date = DaysToDateString(today);
+  QueueFetchTask(std::move(task));
 }
 
-void ProcessFetchQueue() {
-  // ---- Fix Main Loop: Worker akan tidur sampai ada kerjaan
-  while (g_bWorkerThreadRun) {
-    std::string task_key;
-    FetchTask task;
+// Jumlah bar di bars[0..n) (urut) yang tanggalnya sebelum epoch day 'day'
+static int BarsBefore(const Quotation* bars, int n, int32_t day) {
+  if (day == INT32_MAX) return n;
+  const DATE_TIME_INT date = DaysToEodDate(day);
+  return static_cast<int>(std::lower_bound(bars, bars + n, date, [](const Quotation& q, DATE_TIME_INT d) {
+    return q.DateTime.Date < d;
+  }) - bars);
+}
 
-    {
-      std::unique_lock<std::mutex> lock(g_fetchQueueMtx);
-      g_fetchQueueCV.wait(lock, [&] {
-        return !g_fetchQueue.empty() || !g_bWorkerThreadRun;
-      });
-
-      if (!g_bWorkerThreadRun) break;
-      if (g_fetchQueue.empty()) continue; 
-
-      auto it = g_fetchQueue.begin();
-      task_key = it->first;
-      task = std::move(it->second);
-      g_fetchQueue.erase(it);
-    } 
-
-    // Tandai "Lagi Dikerjain"
-    {
-      std::lock_guard<std::mutex> lock(g_fetchMtx);
-      g_isFetching[task_key] = true;
-    }
+static bool LiveFeedConnected() {
+  std::shared_ptr<WsClient> wsClient = g_wsClient;
+  return wsClient && wsClient->isConnected();
+}
 
-    // --- DISPATCHER UTAMA WORKER ---
-    switch (task.type) {
-      case FetchTaskType::GET_CANDLES:
-        LogBridge("Worker processing CANDLES: " + task.symbol);
-        // fetchAndCache udah ngurus g_isFetching-nya sendiri,
-        // tapi kita harus ubah key-nya
-        fetchAndCache(task.symbol, task.from_date, task.to_date, task.preload); 
-        break;
-
-      case FetchTaskType::GET_OWNERSHIP_INDIV:
-        LogBridge("Worker processing OWN_INDIV: " + task.symbol);
-        OwnershipFetcher::fetch(task.symbol, "Individual");
-        break;
-
-      case FetchTaskType::GET_OWNERSHIP_CORP:
-        LogBridge("Worker processing OWN_CORP: " + task.symbol);
-        OwnershipFetcher::fetch(task.symbol, "Perusahaan");
-        break;
-      
-      case FetchTaskType::GET_FINANCIALS:
-        LogBridge("Worker processing FINANCIALS: " + task.symbol);
-        FinancialFetcher::fetch(task.symbol);
-        break;
-      
-      case FetchTaskType::GET_RITEL_FLOW:
-        LogBridge("Worker processing RITEL_FLOW: " + task.symbol);
-        RitelFetcher::fetch(task.symbol);
-        break;
-
-      case FetchTaskType::GET_BROKER_FLOW:
-        LogBridge("Worker processing BROKER_FLOW (" + task.extra_param + "): " + task.symbol);
-        RitelFetcher::fetch(task.symbol, task.extra_param);   // Panggil fetcher pakai parameter broker
-        break;
-    }
-    
-    // Hapus tanda "Lagi Dikerjain"
-    {
-        std::lock_guard<std::mutex> lock(g_fetchMtx);
-        g_isFetching.erase(task_key);
-    }
-    
-    // Kasih tau AmiBroker buat refresh (penting!)
-    if (g_hAmiBrokerWnd) PostMessage(g_hAmiBrokerWnd, WM_USER_STREAMING_UPDATE, 0, 0);
+// Disk cache -> store (sekali per sesi). Return snapshot yang berlaku.
+static std::shared_ptr<const BarSeries> InitFromDiskCache(SymbolId symbolId) {
+  const std::string& symbol = SymbolTable::instance().name(symbolId);
+  std::vector<Quotation> diskBars;
+  if (BarCache::load(symbol, diskBars) && !diskBars.empty()) {
+    LogBridge("Disk cache hit for " + symbol + " with " + std::to_string(diskBars.size()) + " bars.");
+  }
+  return gDataStore.initHistorical(symbolId, std::move(diskBars));
+}
 
-    std::this_thread::sleep_for(std::chrono::milliseconds(400)); // Jeda API
+void PrefetchHistory(SymbolId symbolId, FetchPriority priority, const CancelToken& cancel,
+                     std::vector<std::shared_future<bool>>* futures) {
+  if (gDataStore.getHistorical(symbolId)) {
+    // Sudah dicek di sesi ini; kalau ada rentang yang masih jalan, ikut tunggu
+    if (futures) {
+      uint64_t keys[GapPlanner::kMaxRanges + 1];
+      size_t n = CandleKeysInFlight(symbolId, keys);
+      for (size_t i = 0; i < n; i++) {
+        if (auto flight = TaskRegistry::instance().find(keys[i])) futures->push_back(flight->future());
+      }
+    }
+    return;
   }
 
-  LogBridge("Worker thread shutting down.");
+  // Tanpa pQuotes: basisnya cuma disk cache (tanpa disk cache = lookback penuh)
+  auto series = InitFromDiskCache(symbolId);
+  const Quotation* bars = series ? series->bars.data() : nullptr;
+  int n = series ? static_cast<int>(series->bars.size()) : 0;
+  QueueMissingRanges(symbolId, bars, n, LiveFeedConnected(), priority, cancel, futures);
+}
+
+void PrefetchExtraData(SymbolId symbolId, const CancelToken& cancel, std::vector<std::shared_future<bool>>* futures) {
+  const FetchTaskType types[] = {
+    FetchTaskType::GET_OWNERSHIP_INDIV,
+    FetchTaskType::GET_OWNERSHIP_CORP,
+    FetchTaskType::GET_FINANCIALS,
+    FetchTaskType::GET_RITEL_FLOW,
+  };
+  for (FetchTaskType type : types) {
+    FetchTask task;
+    task.type = type;
+    task.priority = FetchPriority::EXTRADATA;
+    task.symbolId = symbolId;
+    task.cancel = cancel;
+
+    // Hasil kosong / gagal yang masih dalam TTL tidak di-fetch ulang
+    std::shared_future<bool> future;
+    QueueExtraDataFetch(std::move(task), false, &future);
+    if (futures && future.valid()) futures->push_back(future);
+  }
 }
 
 int GetQuotesEx_Bridge(LPCTSTR pszTicker, int nPeriodicity, int nLastValid, int nSize, struct Quotation* pQuotes)
 {
-  std::string symbol(pszTicker);
   if (nPeriodicity != PERIODICITY_EOD) return nLastValid + 1;
 
-  std::vector<Candle> final_candles;
-  bool hasHist = gDataStore.hasHistorical(symbol);
+  // Ticker -> ID integer sekali di awal; semua lookup berikutnya pakai ID
+  SymbolId symbolId = SymbolTable::instance().intern(pszTicker);
+  if (symbolId == kNoSymbol) return nLastValid + 1;   // Tabel simbol penuh
+  const std::string& symbol = SymbolTable::instance().name(symbolId);
+  const uint64_t candleKey = MakeCandleKey(symbolId);
+
+  // Bar milik AmiBroker dipakai langsung sebagai basis (tanpa copy ke preload).
+  // Tanggal dinormalisasi in-place supaya bisa dibandingkan sebagai integer.
+  // Bar overlay live dari panggilan sebelumnya (IsLiveBar) cuma perkiraan intraday:
+  // dicatat sebelum tandanya hilang dinormalisasi, supaya di-fetch ulang.
+  int count = std::max(0, std::min(nLastValid + 1, nSize));
+  int32_t provisionalDay = INT32_MAX;
+  for (int i = 0; i < count; i++) {
+    if (provisionalDay == INT32_MAX && IsLiveBar(pQuotes[i])) provisionalDay = EodDateToDays(pQuotes[i].DateTime.Date);
+    DATE_TIME_INT normalized = NormalizeEodDate(pQuotes[i].DateTime.Date);
+    if (pQuotes[i].DateTime.Date != normalized) pQuotes[i].DateTime.Date = normalized;
+  }
 
-  if (hasHist) {
-    LogIfDebug("Cache HIT for " + symbol);
-    final_candles = gDataStore.getHistorical(symbol);
+  std::shared_ptr<const LiveQuote> live;
+  if (LiveFeedConnected()) live = gDataStore.getLiveQuote(symbolId);
+  // Overlay hari ini yang masih tersambung ke live quote diganti lagi di bawah
+  if (live && provisionalDay == EodDateToDays(TodayEodDate())) provisionalDay = INT32_MAX;
 
-    {
-      std::shared_ptr<WsClient> wsClient = g_wsClient;
+  // Pegang snapshot (shared, immutable) selama copy-out. Tidak ada copy vector.
+  std::shared_ptr<const BarSeries> series = gDataStore.getHistorical(symbolId);
 
-      if (wsClient && wsClient->isConnected()) {
-        std::lock_guard<std::mutex> dslock(g_dataStoreMtx);
-        gDataStore.mergeLiveToHistorical(symbol);
-        final_candles = gDataStore.getHistorical(symbol);
+  if (series) {
+    LogIfDebug("Cache HIT for " + symbol);
+    count = MergeBarsInPlace(pQuotes, count, nSize, series->bars.data(), series->bars.size());
+    const int planned = BarsBefore(pQuotes, count, provisionalDay);
+
+    uint64_t busy[GapPlanner::kMaxRanges + 1];
+    size_t busyCount = CandleKeysInFlight(symbolId, busy);
+    if (busyCount > 0) {
+      // Diminta lagi sebelum selesai (ekor atau lubang tengah): chart yang menunggu
+      // simbol ini ambil alih tugasnya (naik kelas + token chart). Scan yang cuma
+      // lewat tidak mengubah apa-apa.
+      CandleRequester requester = ClassifyCandleRequest(symbolId);
+      if (requester.priority == FetchPriority::INTERACTIVE) {
+        for (size_t i = 0; i < busyCount; i++) {
+          FetchPool::instance().promote(busy[i], FetchPriority::INTERACTIVE, requester.cancel);
+        }
       }
+    } else if (planned < count) {
+      // Bar overlay live lama masih di buffer AmiBroker: ambil bar final dari server
+      CandleRequester requester = ClassifyCandleRequest(symbolId);
+      QueueMissingRanges(symbolId, pQuotes, planned, live != nullptr, requester.priority, requester.cancel, nullptr);
+    } else {
+      QueueRevalidate(symbolId, *series, candleKey, pQuotes, count, live != nullptr);
     }
   } else {
-    // CACHE MISS
+    // CACHE MISS: pertama kali simbol ini diminta di sesi ini
     LogIfDebug("Cache MISS for " + symbol);
 
-    bool is_already_fetching_or_queued = false;
-    {
-      std::lock_guard<std::mutex> lock(g_fetchMtx);
-      is_already_fetching_or_queued = (g_isFetching.find(symbol) != g_isFetching.end());
-    }
-    {
-      std::lock_guard<std::mutex> lock(g_fetchQueueMtx);
-      if (g_fetchQueue.find(symbol) != g_fetchQueue.end()) {
-        is_already_fetching_or_queued = true;
-      }
+    // ---- DISK CACHE: bar dari sesi sebelumnya (bulk copy dari mapping).
+    // Dipublish ke store walau kosong, sekaligus menandai simbol sudah dicek.
+    series = InitFromDiskCache(symbolId);
+    if (series) {
+      count = MergeBarsInPlace(pQuotes, count, nSize, series->bars.data(), series->bars.size());
     }
 
-    if (!is_already_fetching_or_queued) {
-      // ---- PRELOAD from AmiBroker ----
-      std::vector<Candle> preload;
-      if (nLastValid >= 0) {
-        preload.reserve(nLastValid + 1);
-        for (int i = 0; i <= nLastValid; ++i) {
-          Candle c;
-          c.date = AmiDateToString(pQuotes[i].DateTime.PackDate);
-          c.open = pQuotes[i].Open;
-          c.high = pQuotes[i].High;
-          c.low = pQuotes[i].Low;
-          c.close = pQuotes[i].Price;
-          c.volume = pQuotes[i].Volume;
-          c.frequency = pQuotes[i].OpenInterest;
-          c.value = pQuotes[i].AuxData1;
-          c.netforeign = pQuotes[i].AuxData2;
-          preload.push_back(c);
-        }
-        LogBridge("Preload data captured for " + symbol + " with " + std::to_string(preload.size()) + " bars.");
-      }
-
-      // Tentukan range tanggal fetch
-      std::string from_date, to_date;
-      auto now = std::chrono::system_clock::now();
-      to_date = timePointToString(now);
-
-      if (nLastValid >= 0) {
-        const auto& lastQuoteDate = pQuotes[nLastValid].DateTime.PackDate;
-        std::tm last_tm = {};
-        last_tm.tm_year = lastQuoteDate.Year - 1900;
-        last_tm.tm_mon  = lastQuoteDate.Month - 1;
-        last_tm.tm_mday = lastQuoteDate.Day;
-        std::time_t last_tt = std::mktime(&last_tm);
-        // auto next_day_tp = std::chrono::system_clock::from_time_t(last_tt) + std::chrono::hours(24);
-        // from_date = timePointToString(next_day_tp);
-        from_date = timePointToString(std::chrono::system_clock::from_time_t(last_tt));
-      } else {
-        int lookback_days = 365 * 2;  // 2 tahun
-        from_date = timePointToString(now - std::chrono::hours(24 * lookback_days));
-      }
-
-      FetchTask task;
-      task.type = FetchTaskType::GET_CANDLES;
-      task.symbol = symbol;
-      task.from_date = from_date;
-      task.to_date = to_date;
-      task.preload = preload;
-      QueueFetchTask(std::move(task)); // Pake fungsi queuer baru kita
-
-      if (!preload.empty()) {
-        gDataStore.setHistorical(symbol, preload);
-      }
-
-      // ---- BANGUNKAN WORKER-NYA!
-      g_fetchQueueCV.notify_one();
-    }
+    // ---- Bandingkan pQuotes + disk dengan kalender, fetch hanya yang kurang
+    CandleRequester requester = ClassifyCandleRequest(symbolId);
+    QueueMissingRanges(symbolId, pQuotes, BarsBefore(pQuotes, count, provisionalDay), live != nullptr,
+                       requester.priority, requester.cancel, nullptr);
+  }
 
-      // Kembalikan data preload (jika ada) agar chart tidak kosong
-      if (!gDataStore.hasHistorical(symbol) && nLastValid >= 0)
-        {
-          // Ambil dari antrian (agak boros, tapi aman)
-          std::lock_guard<std::mutex> lock(g_fetchQueueMtx);
-          auto it = g_fetchQueue.find(symbol);
-          if(it != g_fetchQueue.end() && !it->second.preload.empty()) {
-            gDataStore.setHistorical(symbol, it->second.preload);
-          }
-        }
-        final_candles = gDataStore.getHistorical(symbol); // (Mungkin kosong jika nLastValid < 0)
-
-    } // end cache miss
-
-    if (final_candles.empty()) return 0;
-
-    size_t numToCopy = std::min<size_t>(final_candles.size(), (nSize > 0) ? static_cast<size_t>(nSize) : 0);
-    size_t startIndex = (final_candles.size() > numToCopy) ? (final_candles.size() - numToCopy) : 0;
-
-    for (size_t i = 0; i < numToCopy; ++i) {
-      const auto& candle = final_candles[startIndex + i];
-      struct Quotation& qt = pQuotes[i];
-      qt.DateTime.Date = 0;
-      int year, month, day;
-      if (sscanf_s(candle.date.c_str(), "%d-%d-%d", &year, &month, &day) == 3) {
-        qt.DateTime.PackDate.Year = year;
-        qt.DateTime.PackDate.Month = month;
-        qt.DateTime.PackDate.Day = day;
-        qt.DateTime.PackDate.Minute = DATE_EOD_MINUTES;
-        qt.DateTime.PackDate.Hour = DATE_EOD_HOURS;
-      }
-      qt.Price = static_cast<float>(candle.close);
-      qt.Open = static_cast<float>(candle.open);
-      qt.High = static_cast<float>(candle.high);
-      qt.Low = static_cast<float>(candle.low);
-      qt.Volume = static_cast<float>(candle.volume);
-      qt.OpenInterest = static_cast<float>(candle.frequency);
-      qt.AuxData1 = static_cast<float>(candle.value);
-      qt.AuxData2 = static_cast<float>(candle.netforeign);
+  // ---- Live bar: di-overlay saat copy-out, historis di store tidak diubah
+  if (live && nSize > 0) {
+    DATE_TIME_INT today = TodayEodDate();
+    Quotation* last = (count > 0) ? &pQuotes[count - 1] : nullptr;
+    Quotation liveBar = BuildLiveBar(last, *live, today);
+
+    if (last && last->DateTime.Date == today) {
+      *last = liveBar;
+    } else if (count < nSize) {
+      pQuotes[count++] = liveBar;
+    } else {
+      // Buffer penuh: geser satu, buang bar paling lama
+      memmove(pQuotes, pQuotes + 1, (count - 1) * sizeof(Quotation));
+      pQuotes[count - 1] = liveBar;
     }
+  }
 
-    return static_cast<int>(numToCopy);
+  return count;
 }
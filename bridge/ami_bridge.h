@@ -2,41 +2,32 @@
 
 #include "plugin.h"       // Struct Quotation dan LPCTSTR
 #include "types.h"        // Struct Candle
+#include "bar_series.h"   // BarSeries / Quotation rows
 #include "data_point.h"
-#include <mutex>
-#include <condition_variable>
+#include "symbol_table.h"
+#include "fetch_pool.h"   // FetchTask, FetchPool, TaskRegistry
+#include <future>
 #include <string>
 #include <vector>
 
-// 1. Tipe Tugas
-enum class FetchTaskType {
-    GET_CANDLES,
-    GET_OWNERSHIP_INDIV,
-    GET_OWNERSHIP_CORP,
-    GET_FINANCIALS,
-    GET_RITEL_FLOW,
-    GET_BROKER_FLOW
-};
-
-// 2. Struct Tugas Generik
-struct FetchTask {
-  FetchTaskType type;
-  std::string symbol;
-  
-  // ----- Khusus untuk GET_CANDLES
-  std::string from_date;
-  std::string to_date;
-  std::vector<Candle> preload;
-
-  // ---- Param lain 
-  std::string extra_param;
-};
+int GetQuotesEx_Bridge(LPCTSTR pszTicker, int nPeriodicity, int nLastValid, int nSize, struct Quotation* pQuotes);
+// Tambah tugas. false kalau key yang sama sudah antri / jalan; outFuture
+// (opsional) tetap diisi future flight tersebut untuk ditunggu / di-poll.
+bool QueueFetchTask(FetchTask task, std::shared_future<bool>* outFuture = nullptr);
 
-// ---- Worker Thread 2
-extern std::mutex g_fetchQueueMtx;
-extern std::condition_variable g_fetchQueueCV;
+// ---- Extradata: antrikan hanya kalau status key terakhir sudah lewat TTL-nya
+// (fresh / kosong / gagal, per endpoint dari .env). hasData = store saat ini
+// ada isinya. Key yang baru saja kosong / gagal cukup satu lookup registry.
+// Data yang ada tapi basi tetap dilayani; refresh-nya masuk kelas BACKGROUND.
+bool QueueExtraDataFetch(FetchTask task, bool hasData, std::shared_future<bool>* outFuture = nullptr);
 
-int GetQuotesEx_Bridge(LPCTSTR pszTicker, int nPeriodicity, int nLastValid, int nSize, struct Quotation* pQuotes);
-void ProcessFetchQueue();
-bool QueueFetchTask(FetchTask task);  // Tambah tugas
+// ---- Prefetch tanpa menunggu GetQuotesEx (dipakai warmup). futures (opsional)
+// diisi future tiap tugas, termasuk yang sudah antri sebelumnya. cancel
+// (boleh nullptr) membuang tugas yang masih antri saat pemanggil berhenti.
+void PrefetchHistory(SymbolId symbolId, FetchPriority priority, const CancelToken& cancel,
+                     std::vector<std::shared_future<bool>>* futures);
+void PrefetchExtraData(SymbolId symbolId, const CancelToken& cancel, std::vector<std::shared_future<bool>>* futures);
 
+// ---- Worker pool (jumlah worker & limit per endpoint dari .env)
+void StartFetchWorkers();
+void StopFetchWorkers();
@@ -0,0 +1,312 @@
+#include "fetch_pool.h"
+#include <windows.h>
+#include <algorithm>
+#include <cassert>
+#include <exception>
+
+static void LogPool(const std::string& msg) {
+  SYSTEMTIME t;
+  GetLocalTime(&t);
+  char buf[64];
+  sprintf_s(buf, "[%02d:%02d:%02d.%03d] ", t.wHour, t.wMinute, t.wSecond, t.wMilliseconds);
+  OutputDebugStringA((std::string(buf) + "[FetchPool] " + msg + "\n").c_str());
+}
+
+FetchEndpoint EndpointOf(FetchTaskType type) {
+  switch (type) {
+    case FetchTaskType::GET_CANDLES:          return FetchEndpoint::HISTORICAL;
+    case FetchTaskType::GET_OWNERSHIP_INDIV:
+    case FetchTaskType::GET_OWNERSHIP_CORP:   return FetchEndpoint::OWNERSHIP;
+    case FetchTaskType::GET_FINANCIALS:       return FetchEndpoint::FINANCIALS;
+    case FetchTaskType::GET_RITEL_FLOW:
+    case FetchTaskType::GET_BROKER_FLOW:      return FetchEndpoint::RITELFLOW;
+  }
+  return FetchEndpoint::HISTORICAL;
+}
+
+const char* EndpointName(FetchEndpoint ep) {
+  switch (ep) {
+    case FetchEndpoint::HISTORICAL: return "historical";
+    case FetchEndpoint::OWNERSHIP:  return "ownership";
+    case FetchEndpoint::FINANCIALS: return "financials";
+    case FetchEndpoint::RITELFLOW:  return "ritelflow";
+    default:                        return "?";
+  }
+}
+
+// ---- Kunci unik tugas: [type:8][param:24][symbol:32], tanpa alokasi string
+static constexpr uint32_t kKeyParamMask = 0xFFFFFFu;
+static_assert(SymbolTable::kCapacity < kKeyParamMask, "SymbolId param harus muat 24 bit");
+
+uint64_t MakeTaskKey(FetchTaskType type, SymbolId symbol, SymbolId param) {
+  return (static_cast<uint64_t>(type) << 56) |
+         (static_cast<uint64_t>(param & kKeyParamMask) << 32) |
+         static_cast<uint64_t>(symbol);
+}
+
+// rangeDay 0..2^24-2 (sampai tahun 47000-an); 2^24-1 dipakai ekor (= kNoSymbol termask)
+uint64_t MakeCandleKey(SymbolId symbol, int32_t rangeDay) {
+  assert(rangeDay == kTrailingRange || (rangeDay >= 0 && static_cast<uint32_t>(rangeDay) < kKeyParamMask));
+  uint32_t param = rangeDay == kTrailingRange ? kKeyParamMask : static_cast<uint32_t>(rangeDay);
+  return (static_cast<uint64_t>(FetchTaskType::GET_CANDLES) << 56) |
+         (static_cast<uint64_t>(param) << 32) |
+         static_cast<uint64_t>(symbol);
+}
+
+uint64_t TaskKeyOf(const FetchTask& task) {
+  if (task.type == FetchTaskType::GET_CANDLES) return MakeCandleKey(task.symbolId, task.rangeDay);
+  return MakeTaskKey(task.type, task.symbolId, task.paramId);
+}
+
+CancelToken MakeCancelToken() {
+  static std::atomic<uint32_t> s_generation{0};
+  return std::make_shared<CancelState>(++s_generation);
+}
+
+FetchPool& FetchPool::instance() {
+  static FetchPool inst;
+  return inst;
+}
+
+void FetchPool::start(const FetchPoolConfig& cfg, Runner runner) {
+  std::lock_guard<std::mutex> lock(m_mtx);
+  if (m_running) return;
+
+  m_cfg = cfg;
+  m_cfg.workers = std::max(1, m_cfg.workers);
+  m_cfg.agingInterval = std::max(1, m_cfg.agingInterval);
+  for (int& limit : m_cfg.endpointLimit) limit = std::max(1, limit);
+  m_runner = runner;
+  m_running = true;
+  std::fill(std::begin(m_passedOver), std::end(m_passedOver), 0);
+  m_sinceAged = 0;
+
+  for (int i = 0; i < m_cfg.workers; i++) {
+    m_threads.emplace_back(&FetchPool::workerLoop, this);
+  }
+
+  LogPool("Started " + std::to_string(m_cfg.workers) + " workers (limits: historical=" +
+          std::to_string(m_cfg.endpointLimit[0]) + ", ownership=" + std::to_string(m_cfg.endpointLimit[1]) +
+          ", financials=" + std::to_string(m_cfg.endpointLimit[2]) + ", ritelflow=" +
+          std::to_string(m_cfg.endpointLimit[3]) + ")");
+}
+
+void FetchPool::stop() {
+  std::vector<std::thread> threads;
+  std::vector<std::shared_ptr<TaskFlight>> dropped;
+  {
+    std::lock_guard<std::mutex> lock(m_mtx);
+    if (!m_running) return;
+    m_running = false;
+    threads.swap(m_threads);
+
+    // Tugas yang masih antri tidak akan pernah jalan: keluarkan dari antrian
+    // supaya yang menunggu future-nya (Warmup::run, PrefetchHistory) tidak hang
+    for (auto& order : m_order) {
+      for (uint64_t key : order) {
+        if (QueuedTask* entry = m_queue.find(key)) dropped.push_back(std::move(entry->flight));
+      }
+      order.clear();
+    }
+    m_queue.clear();
+  }
+
+  // BANGUNKAN SEMUA WORKER SUPAYA BISA EXIT
+  m_cv.notify_all();
+  for (auto& flight : dropped) flight->cancel();
+  for (auto& t : threads) {
+    if (t.joinable()) t.join();
+  }
+  LogPool("All workers stopped (" + std::to_string(dropped.size()) + " queued task(s) cancelled).");
+}
+
+bool FetchPool::running() const {
+  std::lock_guard<std::mutex> lock(m_mtx);
+  return m_running;
+}
+
+bool FetchPool::submit(uint64_t key, FetchTask task, std::shared_future<bool>* outFuture) {
+  {
+    std::lock_guard<std::mutex> lock(m_mtx);
+    bool created = false;
+    auto flight = TaskRegistry::instance().begin(key, created);
+    if (outFuture) *outFuture = flight->future();
+
+    // Registry penuh memberi flight yang tidak dipublish (created = true) walau
+    // key-nya masih antri: antrian sendiri tetap sumber kebenaran, jangan timpa
+    QueuedTask* queued = created ? m_queue.find(key) : nullptr;
+    if (queued && outFuture) *outFuture = queued->flight->future();
+
+    if (!created || queued) {
+      adoptLocked(key, std::move(task.cancel));
+      promoteLocked(key, task.priority);
+      return false;   // Udah antri (mungkin baru dinaikkan kelasnya) / ada yang ngerjain
+    }
+    m_order[static_cast<int>(task.priority)].push_back(key);
+    QueuedTask& entry = m_queue[key];
+    entry.flight = std::move(flight);
+    entry.task = std::move(task);
+    adoptLocked(key, entry.task.cancel);
+  }
+  m_cv.notify_one();
+  return true;
+}
+
+bool FetchPool::promote(uint64_t key, FetchPriority priority, CancelToken cancel) {
+  std::lock_guard<std::mutex> lock(m_mtx);
+  if (cancel) adoptLocked(key, std::move(cancel));
+  return promoteLocked(key, priority);
+}
+
+// Peminta baru menempel ke tugas antri: token yang sudah ada tidak diganti,
+// jadi chart dan scan yang berbagi satu flight sama-sama harus batal dulu.
+// Peminta tanpa token butuh hasilnya tanpa syarat (pinned). Token yang sudah
+// batal dibuang supaya daftar tidak tumbuh selama tugas menunggu.
+void FetchPool::adoptLocked(uint64_t key, CancelToken cancel) {
+  QueuedTask* entry = m_queue.find(key);
+  if (!entry) return;
+  if (!cancel) {
+    entry->pinned = true;
+    return;
+  }
+  auto& cancels = entry->cancels;
+  cancels.erase(std::remove_if(cancels.begin(), cancels.end(),
+                               [](const CancelToken& t) { return t->cancelled.load(std::memory_order_acquire); }),
+                cancels.end());
+  if (std::find(cancels.begin(), cancels.end(), cancel) == cancels.end()) cancels.push_back(std::move(cancel));
+}
+
+bool FetchPool::QueuedTask::cancelled() const {
+  if (pinned || cancels.empty()) return false;
+  for (const CancelToken& t : cancels) {
+    if (!t->cancelled.load(std::memory_order_acquire)) return false;
+  }
+  return true;
+}
+
+// Pindahkan tugas yang masih antri ke kelas lebih tinggi (angka lebih kecil),
+// masuk di belakang antrian kelas barunya.
+bool FetchPool::promoteLocked(uint64_t key, FetchPriority priority) {
+  QueuedTask* entry = m_queue.find(key);
+  if (!entry || priority >= entry->task.priority) return false;
+  if (entry->task.priority == FetchPriority::BACKGROUND) return false;   // Pemanggil sudah dapat data (basi)
+  FetchTask* queued = &entry->task;
+
+  auto& from = m_order[static_cast<int>(queued->priority)];
+  for (auto it = from.begin(); it != from.end(); ++it) {
+    if (*it == key) {
+      from.erase(it);
+      break;
+    }
+  }
+  queued->priority = priority;
+  m_order[static_cast<int>(priority)].push_back(key);
+  return true;
+}
+
+// ---- Pilih tugas: kandidat tiap kelas = tugas runnable paling depan (FIFO,
+// endpoint penuh dilewati). Normalnya kelas tertinggi yang punya kandidat menang.
+// Tiap pop itu menambah hitungan "dilewati" kelas bawah yang juga punya kandidat;
+// setelah agingInterval pop seperti itu, kelas bawah yang paling sering
+// dilewati dapat satu giliran (seri: kelas lebih tinggi), lalu hitungan reset.
+bool FetchPool::popRunnable(uint64_t& key, QueuedTask& entry) {
+  const int kClasses = static_cast<int>(FetchPriority::COUNT);
+  std::deque<uint64_t>::iterator candidate[kClasses];
+  int top = -1;
+
+  for (int c = 0; c < kClasses; c++) {
+    auto& order = m_order[c];
+    candidate[c] = order.end();
+    for (auto it = order.begin(); it != order.end(); ++it) {
+      const QueuedTask* queued = m_queue.find(*it);
+      if (!queued) continue;
+      int ep = static_cast<int>(EndpointOf(queued->task.type));
+      if (m_inFlight[ep] >= m_cfg.endpointLimit[ep]) continue;
+      candidate[c] = it;
+      if (top < 0) top = c;
+      break;
+    }
+  }
+  if (top < 0) return false;
+
+  int pick = top;
+  if (m_sinceAged >= m_cfg.agingInterval) {
+    int aged = -1;
+    for (int c = top + 1; c < kClasses; c++) {
+      if (candidate[c] == m_order[c].end()) continue;
+      if (aged < 0 || m_passedOver[c] > m_passedOver[aged]) aged = c;
+    }
+    if (aged >= 0) pick = aged;
+  }
+
+  if (pick == top) {
+    bool passedOver = false;
+    for (int c = top + 1; c < kClasses; c++) {
+      if (candidate[c] == m_order[c].end()) continue;
+      m_passedOver[c]++;
+      passedOver = true;
+    }
+    if (passedOver) m_sinceAged++;
+  } else {
+    m_passedOver[pick] = 0;
+    m_sinceAged = 0;
+  }
+
+  key = *candidate[pick];
+  m_order[pick].erase(candidate[pick]);
+  QueuedTask* picked = m_queue.find(key);
+  entry = std::move(*picked);
+  m_queue.erase(key);
+  m_inFlight[static_cast<int>(EndpointOf(entry.task.type))]++;
+  entry.flight->markRunning();   // Tandai "Lagi Dikerjain" sebelum lock dilepas
+  return true;
+}
+
+void FetchPool::workerLoop() {
+  while (true) {
+    uint64_t key = 0;
+    QueuedTask entry;
+    bool popped = false;
+
+    {
+      std::unique_lock<std::mutex> lock(m_mtx);
+      // Worker tidur sampai ada tugas yang endpoint-nya belum penuh
+      m_cv.wait(lock, [&] { return !m_running || (popped = popRunnable(key, entry)); });
+      if (!popped) break;
+    }
+
+    bool ok = false;
+    bool cancelled = entry.cancelled();
+    FetchEndpoint endpoint = EndpointOf(entry.task.type);
+    if (cancelled) {
+      LogPool("Dropped cancelled task (" + std::to_string(entry.cancels.size()) + " requester(s), last gen " +
+              std::to_string(entry.cancels.back()->generation) + "): " + entry.task.symbol);
+    } else if (m_cfg.shed && m_cfg.shed(endpoint)) {
+      LogPool(std::string("Shed task (") + EndpointName(endpoint) + " down): " + entry.task.symbol);
+    } else {
+      try {
+        ok = m_runner(entry.task);
+      } catch (const std::exception& e) {
+        LogPool(std::string("Task threw: ") + e.what());
+      } catch (...) {
+        // Exception non-std tetap harus menyelesaikan flight (ok = false -> FAILED),
+        // kalau tidak worker mati dan semua penunggu key ini hang
+        LogPool("Task threw a non-std exception: " + entry.task.symbol);
+      }
+    }
+
+    {
+      std::lock_guard<std::mutex> lock(m_mtx);
+      m_inFlight[static_cast<int>(endpoint)]--;
+    }
+    // Bangunkan semua yang menunggu future (dan bebaskan key untuk fetch berikutnya)
+    if (cancelled) {
+      entry.flight->cancel();
+    } else {
+      entry.flight->complete(ok);
+    }
+
+    // Slot endpoint kosong lagi: worker lain mungkin sedang menunggu endpoint ini
+    m_cv.notify_all();
+  }
+}
@@ -0,0 +1,159 @@
+#pragma once
+
+#include "symbol_table.h"
+#include "id_map.h"
+#include "task_registry.h"
+#include <atomic>
+#include <cstdint>
+#include <deque>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <condition_variable>
+#include <string>
+#include <thread>
+#include <vector>
+
+// 1. Tipe Tugas
+enum class FetchTaskType : uint8_t {
+    GET_CANDLES,
+    GET_OWNERSHIP_INDIV,
+    GET_OWNERSHIP_CORP,
+    GET_FINANCIALS,
+    GET_RITEL_FLOW,
+    GET_BROKER_FLOW
+};
+
+// 2. Kelas prioritas: chart yang sedang dilihat > scan/backfill > extradata > refresh
+enum class FetchPriority : uint8_t {
+  INTERACTIVE,
+  SCAN,
+  EXTRADATA,
+  BACKGROUND,     // Revalidasi cache yang basi: data lama tetap dilayani, tidak di-promote
+  COUNT
+};
+
+// 3. Token pembatalan milik satu peminta (satu chart load, satu sesi scan,
+// satu run warmup). Tugas yang token-nya dibatalkan dibuang pool sebelum
+// menyentuh jaringan. generation = nomor urut peminta (naik terus).
+struct CancelState {
+  explicit CancelState(uint32_t gen) : generation(gen) {}
+  const uint32_t generation;
+  std::atomic<bool> cancelled{false};
+};
+using CancelToken = std::shared_ptr<CancelState>;
+
+CancelToken MakeCancelToken();    // Generasi baru
+
+// Rentang candle = ekor seri sampai hari ini (lihat FetchTask::rangeDay)
+static constexpr int32_t kTrailingRange = -1;
+
+// 4. Struct Tugas Generik
+struct FetchTask {
+  FetchTaskType type;
+  FetchPriority priority = FetchPriority::EXTRADATA;
+  std::string symbol;
+  SymbolId symbolId = kNoSymbol;    // Diisi QueueFetchTask kalau kosong
+  SymbolId paramId = kNoSymbol;     // ID hasil intern extra_param (kode broker)
+  CancelToken cancel;               // nullptr = tidak bisa dibatalkan
+
+  // ----- Khusus untuk GET_CANDLES (satu rentang hasil GapPlanner)
+  int32_t rangeDay = kTrailingRange;  // Epoch day awal lubang di tengah seri; kTrailingRange = ekor
+  std::string from_date;
+  std::string to_date;
+
+  // ---- Param lain
+  std::string extra_param;
+};
+
+// 4. Endpoint backend: tiap endpoint punya batas concurrency sendiri
+enum class FetchEndpoint : uint8_t {
+  HISTORICAL,       // /api/amibroker/historical
+  OWNERSHIP,
+  FINANCIALS,
+  RITELFLOW,        // Ritel flow & broker flow
+  COUNT
+};
+
+FetchEndpoint EndpointOf(FetchTaskType type);
+const char* EndpointName(FetchEndpoint ep);
+
+// Kunci unik tugas (type, simbol, param) dalam satu integer 64-bit
+uint64_t MakeTaskKey(FetchTaskType type, SymbolId symbol, SymbolId param);
+// Kunci tugas GET_CANDLES: slot param berisi rangeDay, bukan SymbolId.
+// Ekor (kTrailingRange) = param kosong, jadi satu key per simbol untuk ekor.
+uint64_t MakeCandleKey(SymbolId symbol, int32_t rangeDay = kTrailingRange);
+// Kunci dari isi tugas: candle pakai rangeDay, tipe lain pakai paramId
+uint64_t TaskKeyOf(const FetchTask& task);
+
+struct FetchPoolConfig {
+  int workers = 4;
+  int endpointLimit[static_cast<int>(FetchEndpoint::COUNT)] = { 4, 2, 2, 2 };
+  // Opsional: true = backend endpoint ini sedang down (circuit breaker), tugas
+  // yang keluar dari antrian langsung digagalkan tanpa menjalankan runner.
+  bool (*shed)(FetchEndpoint endpoint) = nullptr;
+  // Aging: setelah sekian pop kelas atas selagi kelas bawah punya tugas runnable
+  // yang dilewati, satu tugas kelas bawah dijalankan (lalu hitungan mulai lagi)
+  int agingInterval = 8;
+};
+
+// ---- Pool worker fetch.
+// Satu antrian FIFO per kelas prioritas. Worker mengambil tugas runnable
+// (endpoint penuh dilewati) dari kelas tertinggi. Aging dibatasi jumlah, bukan
+// waktu: paling banyak satu tugas kelas bawah per agingInterval pop kelas atas,
+// jadi chart interaktif tidak pernah antri di belakang lebih dari satu tugas
+// scan/extradata per worker, dan kelas bawah tetap jalan (tidak starve).
+// Jeda antar request diatur RateLimiter di WinHttpGetData, bukan di sini.
+class FetchPool {
+public:
+  using Runner = bool (*)(FetchTask& task);    // true = fetch sukses
+
+  static FetchPool& instance();
+
+  void start(const FetchPoolConfig& cfg, Runner runner);
+  void stop();                      // Batalkan tugas yang masih antri, bangunkan semua worker lalu join
+  bool running() const;
+
+  // Return false kalau tugas dengan key yang sama sudah antri / sedang dikerjakan
+  // (dedupe lewat TaskRegistry). Kalau masih antri, peminta baru ikut menempel
+  // (lihat QueuedTask) dan kelasnya dinaikkan kalau perlu. outFuture selalu
+  // diisi future flight yang berlaku.
+  bool submit(uint64_t key, FetchTask task, std::shared_future<bool>* outFuture = nullptr);
+  // cancel (opsional): peminta baru ikut menempel ke tugas yang masih antri
+  bool promote(uint64_t key, FetchPriority priority, CancelToken cancel = nullptr);
+
+private:
+  FetchPool() = default;
+  FetchPool(const FetchPool&) = delete;
+  FetchPool& operator=(const FetchPool&) = delete;
+
+  void workerLoop();
+  // Semua peminta satu tugas antri. Tugas dibuang hanya kalau SEMUA peminta
+  // sudah batal; peminta tanpa token (pinned) tidak pernah batal.
+  struct QueuedTask {
+    FetchTask task;
+    std::shared_ptr<TaskFlight> flight;
+    std::vector<CancelToken> cancels;
+    bool pinned = false;
+
+    bool cancelled() const;
+  };
+
+  bool popRunnable(uint64_t& key, QueuedTask& entry);  // Dipanggil dengan m_mtx terkunci
+  bool promoteLocked(uint64_t key, FetchPriority priority);
+  void adoptLocked(uint64_t key, CancelToken cancel);
+
+  mutable std::mutex m_mtx;
+  std::condition_variable m_cv;
+  std::vector<std::thread> m_threads;
+  bool m_running = false;
+
+  FetchPoolConfig m_cfg;
+  Runner m_runner = nullptr;
+
+  IdMap<QueuedTask> m_queue;        // Key: TaskKey (yang sedang jalan dilacak TaskRegistry)
+  std::deque<uint64_t> m_order[static_cast<int>(FetchPriority::COUNT)];   // FIFO per kelas
+  int m_passedOver[static_cast<int>(FetchPriority::COUNT)] = {};  // Pop kelas atas selagi kelas ini menunggu
+  int m_sinceAged = 0;              // Pop kelas atas sejak tugas aged terakhir
+  int m_inFlight[static_cast<int>(FetchEndpoint::COUNT)] = {};
+};
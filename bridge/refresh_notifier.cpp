@@ -0,0 +1,95 @@
+#include "refresh_notifier.h"
+#include "plugin.h"       // WM_USER_STREAMING_UPDATE
+#include <string>
+
+static void LogRefresh(const std::string& msg) {
+  SYSTEMTIME t;
+  GetLocalTime(&t);
+  char buf[64];
+  sprintf_s(buf, "[%02d:%02d:%02d.%03d] ", t.wHour, t.wMinute, t.wSecond, t.wMilliseconds);
+  OutputDebugStringA((std::string(buf) + "[Refresh] " + msg + "\n").c_str());
+}
+
+RefreshNotifier& RefreshNotifier::instance() {
+  static RefreshNotifier inst;
+  return inst;
+}
+
+RefreshNotifier::RefreshNotifier()
+  : m_inPending(new bool[SymbolTable::kCapacity]()) {
+}
+
+void RefreshNotifier::start(HWND hWnd, int intervalMs) {
+  std::lock_guard<std::mutex> lock(m_mtx);
+  m_hWnd = hWnd;
+  m_interval = std::chrono::milliseconds(intervalMs > 0 ? intervalMs : 0);
+  if (m_running) return;      // Sudah jalan: cukup update window & interval
+
+  m_running = true;
+  m_thread = std::thread(&RefreshNotifier::run, this);
+  LogRefresh("Started, interval " + std::to_string(m_interval.count()) + " ms");
+}
+
+void RefreshNotifier::stop() {
+  {
+    std::lock_guard<std::mutex> lock(m_mtx);
+    if (!m_running) return;
+    m_running = false;
+    m_hWnd = NULL;
+  }
+  m_cv.notify_all();
+  if (m_thread.joinable()) m_thread.join();
+  LogRefresh("Stopped after " + std::to_string(m_refreshCount.load()) + " refreshes");
+}
+
+void RefreshNotifier::signal(SymbolId symbol) {
+  bool perSymbol = symbol < SymbolTable::kCapacity;
+
+  {
+    std::lock_guard<std::mutex> lock(m_mtx);
+    if (perSymbol) {
+      if (!m_inPending[symbol]) {
+        m_inPending[symbol] = true;
+        m_pending.push_back(symbol);
+      }
+    } else {
+      m_pendingAll = true;
+    }
+    if (m_dirty) return;      // Refresh berikutnya sudah terjadwal
+    m_dirty = true;
+  }
+  m_cv.notify_one();
+}
+
+void RefreshNotifier::run() {
+  auto lastEmit = std::chrono::steady_clock::time_point{};
+
+  std::unique_lock<std::mutex> lock(m_mtx);
+  while (true) {
+    m_cv.wait(lock, [&] { return !m_running || m_dirty; });
+    if (!m_running) break;
+
+    // Tahan sampai interval sejak refresh terakhir lewat; signal yang masuk
+    // selama menunggu ikut tergabung ke refresh yang sama
+    m_cv.wait_until(lock, lastEmit + m_interval, [&] { return !m_running; });
+    if (!m_running) break;
+
+#ifdef _DEBUG
+    std::string changed = std::to_string(m_pending.size()) + " symbol(s)" + (m_pendingAll ? " + all" : "");
+#endif
+    for (SymbolId id : m_pending) m_inPending[id] = false;
+    m_pending.clear();
+    m_pendingAll = false;
+    m_dirty = false;
+    HWND hWnd = m_hWnd;
+
+    lock.unlock();
+    if (hWnd) PostMessage(hWnd, WM_USER_STREAMING_UPDATE, 0, 0);
+#ifdef _DEBUG
+    LogRefresh("Refresh #" + std::to_string(m_refreshCount.load() + 1) + ": " + changed);
+#endif
+    lastEmit = std::chrono::steady_clock::now();
+    m_refreshCount.fetch_add(1, std::memory_order_relaxed);
+    lock.lock();
+  }
+}
@@ -0,0 +1,49 @@
+#pragma once
+
+#include "symbol_table.h"
+#include <windows.h>      // HWND
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+// ---- Satu-satunya pengirim WM_USER_STREAMING_UPDATE ke AmiBroker.
+// Producer (worker fetch, callback WS, dialog config) cukup signal(); thread
+// notifier mengirim paling banyak satu refresh per interval, berapapun jumlah
+// signal di antaranya. Simbol yang berubah dikumpulkan (unik) per refresh,
+// hanya untuk log debug berapa simbol yang tergabung di satu refresh.
+class RefreshNotifier {
+public:
+  static RefreshNotifier& instance();
+
+  void start(HWND hWnd, int intervalMs);
+  void stop();
+
+  // symbol = kNoSymbol artinya "semua" (misal daftar simbol berubah)
+  void signal(SymbolId symbol = kNoSymbol);
+
+  uint64_t refreshCount() const { return m_refreshCount.load(std::memory_order_relaxed); }
+
+private:
+  RefreshNotifier();
+  RefreshNotifier(const RefreshNotifier&) = delete;
+  RefreshNotifier& operator=(const RefreshNotifier&) = delete;
+
+  void run();
+
+  std::thread m_thread;
+  std::mutex m_mtx;
+  std::condition_variable m_cv;
+  bool m_running = false;
+  bool m_dirty = false;
+  HWND m_hWnd = NULL;
+  std::chrono::milliseconds m_interval{100};
+
+  std::vector<SymbolId> m_pending;          // Simbol sejak refresh terakhir (unik)
+  std::unique_ptr<bool[]> m_inPending;      // Index = SymbolId, dedupe m_pending
+  bool m_pendingAll = false;
+  std::atomic<uint64_t> m_refreshCount{0};
+};
@@ -0,0 +1,105 @@
+#include "task_registry.h"
+
+TaskRegistry::TaskRegistry()
+  : m_keys(new std::atomic<uint64_t>[kSlots]),
+    m_flights(new std::shared_ptr<TaskFlight>[kSlots]) {
+  for (uint32_t i = 0; i < kSlots; ++i) m_keys[i].store(kEmptyKey, std::memory_order_relaxed);
+}
+
+// Mix 64-bit (splitmix64 finalizer): bit type/param di atas ikut tersebar
+uint32_t TaskRegistry::hash(uint64_t key) {
+  key ^= key >> 33;
+  key *= 0xff51afd7ed558ccdull;
+  key ^= key >> 33;
+  return static_cast<uint32_t>(key);
+}
+
+uint32_t TaskRegistry::indexOf(uint64_t key) const {
+  uint32_t idx = hash(key) & (kSlots - 1);
+  for (uint32_t probes = 0; probes < kSlots; ++probes) {
+    uint64_t k = m_keys[idx].load(std::memory_order_acquire);
+    if (k == kEmptyKey) return kSlots;
+    if (k == key) return idx;
+    idx = (idx + 1) & (kSlots - 1);     // Tombstone: lanjut probe
+  }
+  return kSlots;
+}
+
+std::shared_ptr<TaskFlight> TaskRegistry::find(uint64_t key) const {
+  uint32_t idx = indexOf(key);
+  if (idx == kSlots) return nullptr;
+  auto flight = std::atomic_load(&m_flights[idx]);
+  // Slot bisa dibuang & dipakai key lain di antara dua load: cek ulang key-nya
+  if (m_keys[idx].load(std::memory_order_acquire) != key) return nullptr;
+  return flight;
+}
+
+bool TaskRegistry::inFlight(uint64_t key) const {
+  auto flight = find(key);
+  return flight && flight->inFlight();
+}
+
+// ---- Tabel hampir penuh: buang semua flight yang sudah selesai (slot jadi
+// tombstone), lalu kosongkan lagi tombstone di ujung rantai probe (slot
+// berikutnya kosong = tidak ada key yang dicari lewat slot itu).
+void TaskRegistry::evictCompleted() {
+  for (uint32_t i = 0; i < kSlots; ++i) {
+    uint64_t k = m_keys[i].load(std::memory_order_relaxed);
+    if (k == kEmptyKey || k == kTombKey) continue;
+    auto flight = std::atomic_load(&m_flights[i]);
+    if (flight && flight->inFlight()) continue;
+
+    m_keys[i].store(kTombKey, std::memory_order_release);
+    std::atomic_store(&m_flights[i], std::shared_ptr<TaskFlight>());
+  }
+
+  for (uint32_t i = 0; i < kSlots; ++i) {
+    if (m_keys[i].load(std::memory_order_relaxed) != kEmptyKey) continue;
+    uint32_t j = (i - 1) & (kSlots - 1);
+    while (m_keys[j].load(std::memory_order_relaxed) == kTombKey) {
+      m_keys[j].store(kEmptyKey, std::memory_order_release);
+      m_used--;
+      j = (j - 1) & (kSlots - 1);
+    }
+  }
+}
+
+std::shared_ptr<TaskFlight> TaskRegistry::begin(uint64_t key, bool& created) {
+  std::lock_guard<std::mutex> lock(m_writeMtx);
+
+  uint32_t idx = indexOf(key);
+  if (idx != kSlots) {
+    auto current = std::atomic_load(&m_flights[idx]);
+    if (current && current->inFlight()) {
+      created = false;
+      return current;
+    }
+  }
+
+  auto flight = std::make_shared<TaskFlight>();
+  created = true;
+
+  if (idx != kSlots) {
+    std::atomic_store(&m_flights[idx], flight);
+    return flight;
+  }
+
+  if (m_used >= kMaxUsed) evictCompleted();
+
+  // Key belum ada: tempati tombstone pertama di jalur probe, atau slot kosong
+  idx = hash(key) & (kSlots - 1);
+  for (uint32_t probes = 0; probes < kSlots; ++probes, idx = (idx + 1) & (kSlots - 1)) {
+    uint64_t k = m_keys[idx].load(std::memory_order_relaxed);
+    if (k != kEmptyKey && k != kTombKey) continue;
+    if (k == kEmptyKey) {
+      // Masih penuh (semua key in-flight): tetap jalan tanpa dipublish
+      if (m_used >= kMaxUsed) return flight;
+      m_used++;
+    }
+    // Flight dulu, baru publish key (release) -> reader tidak pernah lihat slot tanpa flight
+    std::atomic_store(&m_flights[idx], flight);
+    m_keys[idx].store(key, std::memory_order_release);
+    return flight;
+  }
+  return flight;
+}
@@ -0,0 +1,108 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <future>
+#include <memory>
+#include <mutex>
+
+// ---- Status satu "penerbangan" fetch untuk satu TaskKey
+enum class FlightState : uint8_t {
+  QUEUED,
+  RUNNING,
+  DONE,       // Fetcher sukses
+  FAILED,     // Fetcher gagal / respons kosong
+  CANCELLED   // Dibuang sebelum jalan (peminta sudah tidak butuh), bukan hasil fetch
+};
+
+// Satu fetch yang sedang / sudah jalan. Semua pemanggil dengan key sama
+// berbagi objek ini: bisa poll state() atau tunggu future() (true = sukses).
+class TaskFlight {
+public:
+  TaskFlight() : m_future(m_promise.get_future().share()) {}
+
+  FlightState state() const { return m_state.load(std::memory_order_acquire); }
+  bool inFlight() const {
+    FlightState s = state();
+    return s == FlightState::QUEUED || s == FlightState::RUNNING;
+  }
+  std::shared_future<bool> future() const { return m_future; }
+
+  // Umur hasil (steady_clock, ms) sejak DONE/FAILED; -1 kalau belum selesai.
+  // Dipakai TTL negative cache extradata (lihat QueueExtraDataFetch).
+  long long ageMs() const {
+    long long done = m_completedMs.load(std::memory_order_acquire);
+    return done < 0 ? -1 : NowMs() - done;
+  }
+
+  void markRunning() { m_state.store(FlightState::RUNNING, std::memory_order_release); }
+  void complete(bool ok) {
+    m_completedMs.store(NowMs(), std::memory_order_release);
+    m_state.store(ok ? FlightState::DONE : FlightState::FAILED, std::memory_order_release);
+    m_promise.set_value(ok);
+  }
+  void cancel() {
+    m_completedMs.store(NowMs(), std::memory_order_release);
+    m_state.store(FlightState::CANCELLED, std::memory_order_release);
+    m_promise.set_value(false);
+  }
+
+private:
+  static long long NowMs() {
+    return std::chrono::duration_cast<std::chrono::milliseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count();
+  }
+
+  std::atomic<FlightState> m_state{FlightState::QUEUED};
+  std::atomic<long long> m_completedMs{-1};
+  std::promise<bool> m_promise;
+  std::shared_future<bool> m_future;
+};
+
+// ---- Registry single-flight: TaskKey (type, simbol, param) -> TaskFlight terakhir.
+// Lookup lock-free (open addressing, key atomik, flight lewat atomic_load);
+// hanya begin() yang ambil mutex. Status selesai/gagal terakhir tetap bisa
+// dibaca setelah fetch beres, sampai tabel hampir penuh: saat itu semua flight
+// yang sudah selesai dibuang (slot jadi tombstone, dipakai ulang key baru).
+// Flight yang masih antri / jalan tidak pernah dibuang.
+class TaskRegistry {
+public:
+  static constexpr uint32_t kSlots = 1u << 16;   // Slot terpakai (key + tombstone) dijaga <= 0.75
+
+  static TaskRegistry& instance() {
+    static TaskRegistry inst;
+    return inst;
+  }
+
+  // Lock-free. nullptr kalau key belum pernah dijadwalkan.
+  std::shared_ptr<TaskFlight> find(uint64_t key) const;
+
+  // Lock-free. true kalau key sedang antri / dikerjakan.
+  bool inFlight(uint64_t key) const;
+
+  // Kalau key masih in-flight: kembalikan flight itu (created = false).
+  // Selain itu buat flight baru dan publish (created = true). Kalau tabel tetap
+  // penuh setelah flight selesai dibuang, flight baru tidak dipublish: pemanggil
+  // (FetchPool::submit) yang harus dedupe lewat antriannya sendiri.
+  std::shared_ptr<TaskFlight> begin(uint64_t key, bool& created);
+
+private:
+  TaskRegistry();
+
+  // ---- Disable Copy/Move
+  TaskRegistry(const TaskRegistry&) = delete;
+  TaskRegistry& operator=(const TaskRegistry&) = delete;
+
+  static constexpr uint64_t kEmptyKey = ~0ull;
+  static constexpr uint64_t kTombKey = ~0ull - 1;   // Key dibuang; probe jalan terus melewatinya
+  static constexpr uint32_t kMaxUsed = kSlots / 4 * 3;
+  static uint32_t hash(uint64_t key);
+  uint32_t indexOf(uint64_t key) const;     // kSlots kalau tidak ada
+  void evictCompleted();                    // Dipanggil dengan m_writeMtx terkunci
+
+  std::unique_ptr<std::atomic<uint64_t>[]> m_keys;
+  std::unique_ptr<std::shared_ptr<TaskFlight>[]> m_flights;   // Diakses lewat std::atomic_load/store
+  uint32_t m_used = 0;                                         // Key + tombstone, dijaga m_writeMtx
+  std::mutex m_writeMtx;
+};
@@ -0,0 +1,125 @@
+#include "warmup.h"
+#include "ami_bridge.h"
+#include "ws_client.h"       // WsClient::getDBSymbols
+#include "http_transport.h"  // GetHttpTransferTotals
+#include "parse_context.h"   // GetParseAllocStats
+#include "symbol_table.h"
+#include <windows.h>
+#include <algorithm>
+#include <future>
+#include <vector>
+
+static void LogWarmup(const std::string& msg) {
+  SYSTEMTIME t;
+  GetLocalTime(&t);
+  char buf[64];
+  sprintf_s(buf, "[%02d:%02d:%02d.%03d] ", t.wHour, t.wMinute, t.wSecond, t.wMilliseconds);
+  OutputDebugStringA((std::string(buf) + "[Warmup] " + msg + "\n").c_str());
+}
+
+static long long SteadyNowMs() {
+  return std::chrono::duration_cast<std::chrono::milliseconds>(
+      std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+Warmup& Warmup::instance() {
+  static Warmup inst;
+  return inst;
+}
+
+void Warmup::start(const std::string& mode, int batchSize) {
+  if (mode != "history" && mode != "all") return;
+
+  std::lock_guard<std::mutex> lock(m_ctlMtx);
+  if (m_thread.joinable()) {
+    if (m_running) return;    // Masih jalan dari load sebelumnya
+    m_thread.join();
+  }
+
+  m_cancel = false;
+  m_token = MakeCancelToken();
+  m_running = true;
+  m_total = 0;
+  m_done = 0;
+  m_failed = 0;
+  m_startedMs = SteadyNowMs();
+  m_thread = std::thread(&Warmup::run, this, mode == "all", std::max(1, batchSize));
+}
+
+void Warmup::stop() {
+  std::lock_guard<std::mutex> lock(m_ctlMtx);
+  m_cancel = true;
+  if (m_token) m_token->cancelled = true;   // Batch yang masih antri di pool ikut dibuang
+  if (m_thread.joinable()) m_thread.join();
+  m_running = false;
+}
+
+Warmup::Progress Warmup::progress() const {
+  Progress p;
+  p.running = m_running;
+  p.total = m_total;
+  p.done = m_done;
+  p.failed = m_failed;
+
+  long long elapsedMs = SteadyNowMs() - m_startedMs;
+  if (p.running && p.done > 0 && p.total > p.done) {
+    p.etaSeconds = static_cast<int>(elapsedMs / p.done * (p.total - p.done) / 1000);
+  }
+  return p;
+}
+
+void Warmup::run(bool withExtraData, int batchSize) {
+  // OLE dipanggil dari thread ini (getDBSymbols urus CoInitialize sendiri)
+  std::vector<std::string> symbols = WsClient::getDBSymbols();
+  m_total = static_cast<int>(symbols.size());
+  LogWarmup("Starting for " + std::to_string(symbols.size()) + " symbols, batch " +
+            std::to_string(batchSize) + (withExtraData ? ", with extradata" : ""));
+
+  for (size_t begin = 0; begin < symbols.size() && !m_cancel; begin += batchSize) {
+    size_t end = std::min(symbols.size(), begin + static_cast<size_t>(batchSize));
+
+    // ---- 1. Antrikan satu batch (history = kelas SCAN, extradata = kelas EXTRADATA)
+    std::vector<std::vector<std::shared_future<bool>>> pending(end - begin);
+    for (size_t i = begin; i < end; i++) {
+      SymbolId id = SymbolTable::instance().intern(symbols[i]);
+      if (id == kNoSymbol) continue;
+      PrefetchHistory(id, FetchPriority::SCAN, m_token, &pending[i - begin]);
+      if (withExtraData) PrefetchExtraData(id, m_token, &pending[i - begin]);
+    }
+
+    // ---- 2. Tunggu batch selesai (poll supaya stop() tidak tertahan)
+    for (auto& futures : pending) {
+      bool ok = true;
+      for (auto& f : futures) {
+        while (!m_cancel && f.wait_for(std::chrono::milliseconds(200)) != std::future_status::ready) {}
+        if (m_cancel) break;
+        ok = f.get() && ok;
+      }
+      if (m_cancel) break;
+      if (!ok) m_failed++;
+      m_done++;
+    }
+  }
+
+  if (m_cancel) {
+    LogWarmup("Cancelled at " + std::to_string(m_done.load()) + "/" + std::to_string(m_total.load()));
+  } else {
+    long long elapsedMs = SteadyNowMs() - m_startedMs;
+    LogWarmup("Finished " + std::to_string(m_done.load()) + " symbols (" + std::to_string(m_failed.load()) +
+              " with failures) in " + std::to_string(elapsedMs / 1000) + " s");
+
+    HttpTransferTotals http = GetHttpTransferTotals();
+    LogWarmup("HTTP so far: " + std::to_string(http.responses) + " responses (" +
+              std::to_string(http.compressedResponses) + " compressed), " +
+              std::to_string(http.wireBytes / 1024) + " KB on the wire -> " +
+              std::to_string(http.decodedBytes / 1024) + " KB decoded");
+
+    // Setelah batch pertama, growths mestinya diam: parse berikutnya tanpa alokasi heap
+    ParseAllocStats parse = GetParseAllocStats();
+    LogWarmup("Parse contexts: " + std::to_string(parse.contexts) + " threads, " +
+              std::to_string(parse.parses) + " parses, " + std::to_string(parse.bufferGrowths) +
+              " buffer growths, " + std::to_string(parse.parserGrowths) + " parser growths, " +
+              std::to_string(parse.transportGrowths) + " transport growths");
+  }
+  m_running = false;
+}
@@ -0,0 +1,49 @@
+#pragma once
+
+#include "fetch_pool.h"     // CancelToken
+#include <atomic>
+#include <chrono>
+#include <mutex>
+#include <string>
+#include <thread>
+
+// ---- Warmup prefetch setelah database dibuka.
+// Ambil daftar simbol DB (OLE), lalu antrikan refresh history (+ extradata)
+// per batch. Batch berikutnya baru diantrikan setelah semua future batch
+// sebelumnya selesai, jadi antrian tidak pernah kebanjiran dan chart
+// interaktif tetap bisa menyalip (lihat FetchPriority).
+class Warmup {
+public:
+  struct Progress {
+    bool running = false;
+    int total = 0;            // Jumlah simbol
+    int done = 0;             // Simbol yang semua tugasnya sudah selesai
+    int failed = 0;           // Simbol dengan minimal satu tugas gagal
+    int etaSeconds = -1;      // -1 = belum bisa diperkirakan
+  };
+
+  static Warmup& instance();
+
+  // mode: "history" atau "all" (history + extradata). Selain itu tidak jalan.
+  void start(const std::string& mode, int batchSize);
+  void stop();                // Batalkan, termasuk tugas warmup yang masih antri di pool
+
+  Progress progress() const;
+
+private:
+  Warmup() = default;
+  Warmup(const Warmup&) = delete;
+  Warmup& operator=(const Warmup&) = delete;
+
+  void run(bool withExtraData, int batchSize);
+
+  std::thread m_thread;
+  std::mutex m_ctlMtx;                      // Serialisasi start/stop
+  std::atomic<bool> m_cancel{false};
+  CancelToken m_token;                      // Token semua tugas run ini (dijaga m_ctlMtx)
+  std::atomic<bool> m_running{false};
+  std::atomic<int> m_total{0};
+  std::atomic<int> m_done{0};
+  std::atomic<int> m_failed{0};
+  std::atomic<long long> m_startedMs{0};    // steady_clock, untuk ETA
+};
@@ -0,0 +1,133 @@
+#ifndef CIVIL_DATE_H
+#define CIVIL_DATE_H
+
+#include <cstdint>
+#include <string_view>
+
+// ---- Aritmetika tanggal kalender (proleptic Gregorian) tanpa mktime / time zone.
+// ---- "Epoch day" = jumlah hari sejak 1970-01-01 (bisa negatif).
+// ---- Algoritma days_from_civil / civil_from_days dari Howard Hinnant.
+// ---- Semua fungsi constexpr, tanpa alokasi / locale / sscanf. Konversi packed
+// ---- date AmiBroker (butuh plugin.h) ada di bar_series.h di atas fungsi ini.
+namespace CivilDate {
+
+// ---- Zona waktu bursa: IDX pakai WIB (UTC+7), tanpa DST. Konversi Unix
+// ---- selalu eksplisit pakai offset ini, bukan zona waktu mesin (mktime/localtime).
+constexpr int32_t kExchangeUtcOffsetSec = 7 * 3600;
+constexpr int64_t kSecondsPerDay = 86400;
+
+constexpr int32_t DaysFromCivil(int y, int m, int d) {
+  y -= m <= 2 ? 1 : 0;
+  const int era = (y >= 0 ? y : y - 399) / 400;
+  const unsigned yoe = static_cast<unsigned>(y - era * 400);                          // [0, 399]
+  const unsigned doy = (153u * static_cast<unsigned>(m + (m > 2 ? -3 : 9)) + 2u) / 5u + static_cast<unsigned>(d) - 1u;
+  const unsigned doe = yoe * 365u + yoe / 4u - yoe / 100u + doy;                      // [0, 146096]
+  return era * 146097 + static_cast<int32_t>(doe) - 719468;
+}
+
+struct Ymd {
+  int year;
+  int month;    // 1..12
+  int day;      // 1..31
+};
+
+constexpr Ymd CivilFromDays(int32_t z) {
+  z += 719468;
+  const int32_t era = (z >= 0 ? z : z - 146096) / 146097;
+  const unsigned doe = static_cast<unsigned>(z - era * 146097);
+  const unsigned yoe = (doe - doe / 1460u + doe / 36524u - doe / 146096u) / 365u;
+  const unsigned doy = doe - (365u * yoe + yoe / 4u - yoe / 100u);
+  const unsigned mp = (5u * doy + 2u) / 153u;
+  const unsigned d = doy - (153u * mp + 2u) / 5u + 1u;
+  const unsigned m = mp < 10u ? mp + 3u : mp - 9u;
+  const int y = static_cast<int>(yoe) + era * 400 + (m <= 2u ? 1 : 0);
+  return Ymd{ y, static_cast<int>(m), static_cast<int>(d) };
+}
+
+// 0 = Minggu ... 6 = Sabtu (1970-01-01 = Kamis)
+constexpr int Weekday(int32_t days) {
+  return days >= -4 ? (days + 4) % 7 : (days + 5) % 7 + 6;
+}
+
+constexpr bool IsWeekday(int32_t days) {
+  return Weekday(days) != 0 && Weekday(days) != 6;
+}
+
+// Jumlah hari Senin-Jumat di [from, to] (inklusif). 0 kalau from > to.
+constexpr int32_t WeekdaysInRange(int32_t from, int32_t to) {
+  if (from > to) return 0;
+  const int32_t total = to - from + 1;
+  int32_t count = (total / 7) * 5;
+  for (int32_t d = from + (total / 7) * 7; d <= to; ++d) {
+    if (IsWeekday(d)) ++count;
+  }
+  return count;
+}
+
+// ---- Epoch day <-> Unix detik. Unix = 00:00 waktu lokal zona (default bursa).
+constexpr int64_t UnixFromDays(int32_t days, int32_t utcOffsetSec = kExchangeUtcOffsetSec) {
+  return static_cast<int64_t>(days) * kSecondsPerDay - utcOffsetSec;
+}
+
+// Tanggal lokal zona dari Unix detik (floor, aman untuk nilai negatif)
+constexpr int32_t DaysFromUnix(int64_t unixSec, int32_t utcOffsetSec = kExchangeUtcOffsetSec) {
+  const int64_t local = unixSec + utcOffsetSec;
+  return static_cast<int32_t>(local >= 0 ? local / kSecondsPerDay : (local - kSecondsPerDay + 1) / kSecondsPerDay);
+}
+
+// ---- "YYYY-MM-DD" (tepat 10 karakter). false kalau format / range bulan-hari salah.
+constexpr bool ParseIsoYmd(std::string_view s, Ymd& out) {
+  if (s.size() != 10 || s[4] != '-' || s[7] != '-') return false;
+  int v[8] = {};
+  const int pos[8] = { 0, 1, 2, 3, 5, 6, 8, 9 };
+  for (int i = 0; i < 8; i++) {
+    const unsigned digit = static_cast<unsigned>(s[pos[i]] - '0');
+    if (digit > 9) return false;
+    v[i] = static_cast<int>(digit);
+  }
+  out.year = v[0] * 1000 + v[1] * 100 + v[2] * 10 + v[3];
+  out.month = v[4] * 10 + v[5];
+  out.day = v[6] * 10 + v[7];
+  return out.month >= 1 && out.month <= 12 && out.day >= 1 && out.day <= 31;
+}
+
+constexpr bool ParseIsoDate(std::string_view s, int32_t& days) {
+  Ymd ymd{ 0, 0, 0 };
+  if (!ParseIsoYmd(s, ymd)) return false;
+  days = DaysFromCivil(ymd.year, ymd.month, ymd.day);
+  return true;
+}
+
+// Epoch day -> "YYYY-MM-DD" + NUL ke out (minimal 11 byte). Tahun 0000..9999.
+constexpr void FormatIsoDate(int32_t days, char* out) {
+  const Ymd ymd = CivilFromDays(days);
+  const int fields[3] = { ymd.year, ymd.month, ymd.day };
+  const int widths[3] = { 4, 2, 2 };
+  int p = 0;
+  for (int f = 0; f < 3; f++) {
+    if (f > 0) out[p++] = '-';
+    int value = fields[f];
+    for (int i = widths[f] - 1; i >= 0; i--) {
+      out[p + i] = static_cast<char>('0' + value % 10);
+      value /= 10;
+    }
+    p += widths[f];
+  }
+  out[p] = '\0';
+}
+
+static_assert(DaysFromCivil(1970, 1, 1) == 0, "epoch");
+static_assert(DaysFromCivil(2000, 3, 1) == 11017, "leap year handling");
+static_assert(CivilFromDays(11017).month == 3 && CivilFromDays(11017).day == 1, "round trip");
+static_assert(Weekday(0) == 4, "1970-01-01 = Kamis");
+static_assert(WeekdaysInRange(DaysFromCivil(2024, 4, 8), DaysFromCivil(2024, 4, 14)) == 5, "satu minggu");
+static_assert(UnixFromDays(DaysFromCivil(2024, 1, 2)) == 1704128400, "2024-01-02 00:00 WIB");
+static_assert(DaysFromUnix(1704128400) == DaysFromCivil(2024, 1, 2), "round trip Unix");
+static_assert(DaysFromUnix(1704128399) == DaysFromCivil(2024, 1, 1), "23:59:59 WIB masih hari sebelumnya");
+static_assert(DaysFromUnix(-1, 0) == -1, "floor untuk Unix negatif");
+static_assert([] { int32_t d = 0; return ParseIsoDate("2024-02-29", d) && d == DaysFromCivil(2024, 2, 29); }(), "parse ISO");
+static_assert([] { int32_t d = 0; return !ParseIsoDate("2024-13-01", d) && !ParseIsoDate("2024-1-01", d); }(), "format tetap");
+
+} // namespace CivilDate
+
+#endif // CIVIL_DATE_H
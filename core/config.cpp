@@ -2,6 +2,7 @@
 #include "dotenv.h"   // init()
 #include <stdexcept>  // throw error
 #include <cstdlib>    // std::getenv
+#include <sstream>    // parse "a,b,c"
 
 // ---- Implementasi method static getInstance()
 Config& Config::getInstance() {
@@ -20,6 +21,30 @@ Config::Config() {
   host = getEnvVar("PLUGIN_HOST");
   username = getEnvVar("PLUGIN_USERNAME");
   socket_url = getEnvVar("PLUGIN_SOCKET");
+
+  // Variabel opsional: pakai default kalau tidak diset
+  cache_dir = getOptionalEnvVar("PLUGIN_CACHE_DIR", "");
+  fetch_workers = getOptionalIntEnvVar("PLUGIN_FETCH_WORKERS", 4);
+  fetch_limit_historical = getOptionalIntEnvVar("PLUGIN_FETCH_LIMIT_HISTORICAL", 4);
+  fetch_limit_ownership = getOptionalIntEnvVar("PLUGIN_FETCH_LIMIT_OWNERSHIP", 2);
+  fetch_limit_financials = getOptionalIntEnvVar("PLUGIN_FETCH_LIMIT_FINANCIALS", 2);
+  fetch_limit_ritelflow = getOptionalIntEnvVar("PLUGIN_FETCH_LIMIT_RITELFLOW", 2);
+  warmup_mode = getOptionalEnvVar("PLUGIN_WARMUP", "off");
+  warmup_batch = getOptionalIntEnvVar("PLUGIN_WARMUP_BATCH", 20);
+  refresh_interval_ms = getOptionalIntEnvVar("PLUGIN_REFRESH_INTERVAL_MS", 100);
+  rate_historical = getRateLimitEnvVar("PLUGIN_RATE_HISTORICAL", { 5.0, 5, 2000 });
+  rate_ownership = getRateLimitEnvVar("PLUGIN_RATE_OWNERSHIP", { 2.5, 3, 2000 });
+  rate_financials = getRateLimitEnvVar("PLUGIN_RATE_FINANCIALS", { 2.5, 3, 2000 });
+  rate_ritelflow = getRateLimitEnvVar("PLUGIN_RATE_RITELFLOW", { 2.5, 3, 2000 });
+  http_deadline_ms = getOptionalIntEnvVar("PLUGIN_HTTP_DEADLINE_MS", 30000);
+  http_retries = getOptionalIntEnvVar("PLUGIN_HTTP_RETRIES", 3);
+  breaker_threshold = getOptionalIntEnvVar("PLUGIN_BREAKER_THRESHOLD", 5);
+  breaker_cooldown_ms = getOptionalIntEnvVar("PLUGIN_BREAKER_COOLDOWN_MS", 15000);
+  historical_format = getOptionalEnvVar("PLUGIN_HISTORICAL_FORMAT", "auto");
+  ttl_historical = getTtlEnvVar("PLUGIN_TTL_HISTORICAL", { 1800, 0, 60 });     // Koreksi bar & ganti hari
+  ttl_ownership = getTtlEnvVar("PLUGIN_TTL_OWNERSHIP", { 43200, 21600, 60 });     // Data bulanan
+  ttl_financials = getTtlEnvVar("PLUGIN_TTL_FINANCIALS", { 43200, 21600, 60 });   // Data kuartalan
+  ttl_ritelflow = getTtlEnvVar("PLUGIN_TTL_RITELFLOW", { 3600, 1800, 60 });       // Data harian
 }
 
 // ---- Implementasi Getters
@@ -35,6 +60,94 @@ std::string Config::getSocketUrl() const {
   return socket_url;
 }
 
+std::string Config::getCacheDir() const {
+  return cache_dir;
+}
+
+int Config::getFetchWorkers() const {
+  return fetch_workers;
+}
+
+int Config::getFetchLimitHistorical() const {
+  return fetch_limit_historical;
+}
+
+int Config::getFetchLimitOwnership() const {
+  return fetch_limit_ownership;
+}
+
+int Config::getFetchLimitFinancials() const {
+  return fetch_limit_financials;
+}
+
+int Config::getFetchLimitRitelFlow() const {
+  return fetch_limit_ritelflow;
+}
+
+std::string Config::getWarmupMode() const {
+  return warmup_mode;
+}
+
+int Config::getWarmupBatch() const {
+  return warmup_batch;
+}
+
+int Config::getRefreshIntervalMs() const {
+  return refresh_interval_ms;
+}
+
+RateLimitSetting Config::getRateLimitHistorical() const {
+  return rate_historical;
+}
+
+RateLimitSetting Config::getRateLimitOwnership() const {
+  return rate_ownership;
+}
+
+RateLimitSetting Config::getRateLimitFinancials() const {
+  return rate_financials;
+}
+
+RateLimitSetting Config::getRateLimitRitelFlow() const {
+  return rate_ritelflow;
+}
+
+int Config::getHttpDeadlineMs() const {
+  return http_deadline_ms;
+}
+
+int Config::getHttpRetries() const {
+  return http_retries;
+}
+
+int Config::getBreakerThreshold() const {
+  return breaker_threshold;
+}
+
+int Config::getBreakerCooldownMs() const {
+  return breaker_cooldown_ms;
+}
+
+std::string Config::getHistoricalFormat() const {
+  return historical_format;
+}
+
+CacheTtlSetting Config::getTtlHistorical() const {
+  return ttl_historical;
+}
+
+CacheTtlSetting Config::getTtlOwnership() const {
+  return ttl_ownership;
+}
+
+CacheTtlSetting Config::getTtlFinancials() const {
+  return ttl_financials;
+}
+
+CacheTtlSetting Config::getTtlRitelFlow() const {
+  return ttl_ritelflow;
+}
+
 // ---- Helper function implementation
 std::string Config::getEnvVar(const std::string& key) {
   const char* value = std::getenv(key.c_str());
@@ -44,4 +157,63 @@ std::string Config::getEnvVar(const std::string& key) {
     throw std::runtime_error("Environment variable not found: " + key);
   }
   return std::string(value);
-}
\ No newline at end of file
+}
+
+std::string Config::getOptionalEnvVar(const std::string& key, const std::string& fallback) {
+  const char* value = std::getenv(key.c_str());
+  if (value == nullptr || *value == '\0') return fallback;
+  return std::string(value);
+}
+
+int Config::getOptionalIntEnvVar(const std::string& key, int fallback) {
+  std::string value = getOptionalEnvVar(key, "");
+  if (value.empty()) return fallback;
+  try {
+    return std::stoi(value);
+  } catch (...) {
+    return fallback;    // Nilai bukan angka: pakai default, jangan gagal load plugin
+  }
+}
+
+// Format "rps,burst,target_latency_ms"; field yang kosong / rusak pakai default
+RateLimitSetting Config::getRateLimitEnvVar(const std::string& key, const RateLimitSetting& fallback) {
+  RateLimitSetting setting = fallback;
+  std::string value = getOptionalEnvVar(key, "");
+  if (value.empty()) return setting;
+
+  std::stringstream ss(value);
+  std::string part;
+  int index = 0;
+  while (std::getline(ss, part, ',') && index < 3) {
+    try {
+      if (!part.empty()) {
+        if (index == 0) setting.requestsPerSec = std::stod(part);
+        else if (index == 1) setting.burst = std::stoi(part);
+        else setting.targetLatencyMs = std::stoi(part);
+      }
+    } catch (...) {
+      // Biarkan nilai default untuk field ini
+    }
+    index++;
+  }
+  return setting;
+}
+
+// Format "fresh,empty,failed" (detik); field yang kosong / rusak pakai default
+CacheTtlSetting Config::getTtlEnvVar(const std::string& key, const CacheTtlSetting& fallback) {
+  CacheTtlSetting setting = fallback;
+  std::string value = getOptionalEnvVar(key, "");
+  if (value.empty()) return setting;
+
+  std::stringstream ss(value);
+  std::string part;
+  int* fields[] = { &setting.freshSec, &setting.emptySec, &setting.failedSec };
+  for (int index = 0; index < 3 && std::getline(ss, part, ','); index++) {
+    try {
+      if (!part.empty()) *fields[index] = std::stoi(part);
+    } catch (...) {
+      // Biarkan nilai default untuk field ini
+    }
+  }
+  return setting;
+}
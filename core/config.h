@@ -3,6 +3,20 @@
 
 #include <string>
 
+// ---- Batas rate satu keluarga endpoint, format .env: "rps,burst,target_latency_ms"
+struct RateLimitSetting {
+  double requestsPerSec;    // 0 = tidak dibatasi
+  int burst;
+  int targetLatencyMs;      // Di atas ini rate diturunkan
+};
+
+// ---- TTL status key extradata (detik), format .env: "fresh,empty,failed"
+struct CacheTtlSetting {
+  int freshSec;     // Data ada: umur sebelum di-refresh di background
+  int emptySec;     // Fetch sukses tapi kosong: jangan tanya lagi selama ini
+  int failedSec;    // Fetch gagal: jeda sebelum dicoba lagi
+};
+
 // ---- Singleton Class
 class Config {
 public:
@@ -15,6 +29,44 @@ public:
   std::string getUsername() const;
   std::string getSocketUrl() const;
 
+  // Opsional (boleh tidak ada di .env)
+  std::string getCacheDir() const;      // PLUGIN_CACHE_DIR, kosong = pakai folder database AmiBroker
+
+  // Worker pool fetch (opsional)
+  int getFetchWorkers() const;          // PLUGIN_FETCH_WORKERS, default 4
+  int getFetchLimitHistorical() const;  // PLUGIN_FETCH_LIMIT_HISTORICAL, default 4
+  int getFetchLimitOwnership() const;   // PLUGIN_FETCH_LIMIT_OWNERSHIP, default 2
+  int getFetchLimitFinancials() const;  // PLUGIN_FETCH_LIMIT_FINANCIALS, default 2
+  int getFetchLimitRitelFlow() const;   // PLUGIN_FETCH_LIMIT_RITELFLOW, default 2
+
+  // Warmup prefetch saat database dibuka (opsional)
+  std::string getWarmupMode() const;    // PLUGIN_WARMUP: "off" (default), "history", "all"
+  int getWarmupBatch() const;           // PLUGIN_WARMUP_BATCH, simbol per batch, default 20
+
+  // Jarak minimum antar refresh chart AmiBroker (lihat RefreshNotifier)
+  int getRefreshIntervalMs() const;     // PLUGIN_REFRESH_INTERVAL_MS, default 100
+
+  // Rate limiter per endpoint (opsional)
+  RateLimitSetting getRateLimitHistorical() const;  // PLUGIN_RATE_HISTORICAL, default "5,5,2000"
+  RateLimitSetting getRateLimitOwnership() const;   // PLUGIN_RATE_OWNERSHIP, default "2.5,3,2000"
+  RateLimitSetting getRateLimitFinancials() const;  // PLUGIN_RATE_FINANCIALS, default "2.5,3,2000"
+  RateLimitSetting getRateLimitRitelFlow() const;   // PLUGIN_RATE_RITELFLOW, default "2.5,3,2000"
+
+  // Ketahanan request HTTP (opsional)
+  int getHttpDeadlineMs() const;        // PLUGIN_HTTP_DEADLINE_MS, total per request termasuk retry, default 30000
+  int getHttpRetries() const;           // PLUGIN_HTTP_RETRIES, retry untuk error transient, default 3
+  int getBreakerThreshold() const;      // PLUGIN_BREAKER_THRESHOLD, gagal berturut-turut sebelum OPEN, default 5
+  int getBreakerCooldownMs() const;     // PLUGIN_BREAKER_COOLDOWN_MS, default 15000
+
+  // Format body historical: "auto" minta protobuf (fallback JSON), "json" selalu JSON
+  std::string getHistoricalFormat() const;    // PLUGIN_HISTORICAL_FORMAT, default "auto"
+
+  // TTL cache (opsional). Data basi tetap dilayani, refresh jalan di background.
+  CacheTtlSetting getTtlHistorical() const;   // PLUGIN_TTL_HISTORICAL, default "1800,0,60" (empty tidak dipakai)
+  CacheTtlSetting getTtlOwnership() const;    // PLUGIN_TTL_OWNERSHIP, default "43200,21600,60"
+  CacheTtlSetting getTtlFinancials() const;   // PLUGIN_TTL_FINANCIALS, default "43200,21600,60"
+  CacheTtlSetting getTtlRitelFlow() const;    // PLUGIN_TTL_RITELFLOW, default "3600,1800,60"
+
 private:
   // 3. Constructor dibuat private sehingga objek tidak dapat dibuat dari luar
   Config();
@@ -28,9 +80,35 @@ private:
   std::string host;
   std::string username;
   std::string socket_url;
+  std::string cache_dir;
+  int fetch_workers;
+  int fetch_limit_historical;
+  int fetch_limit_ownership;
+  int fetch_limit_financials;
+  int fetch_limit_ritelflow;
+  std::string warmup_mode;
+  int warmup_batch;
+  int refresh_interval_ms;
+  RateLimitSetting rate_historical;
+  RateLimitSetting rate_ownership;
+  RateLimitSetting rate_financials;
+  RateLimitSetting rate_ritelflow;
+  int http_deadline_ms;
+  int http_retries;
+  int breaker_threshold;
+  int breaker_cooldown_ms;
+  std::string historical_format;
+  CacheTtlSetting ttl_historical;
+  CacheTtlSetting ttl_ownership;
+  CacheTtlSetting ttl_financials;
+  CacheTtlSetting ttl_ritelflow;
 
   // Fungsi helper untuk retrieve .env var secara aman
   std::string getEnvVar(const std::string& key);
+  std::string getOptionalEnvVar(const std::string& key, const std::string& fallback);
+  int getOptionalIntEnvVar(const std::string& key, int fallback);
+  RateLimitSetting getRateLimitEnvVar(const std::string& key, const RateLimitSetting& fallback);
+  CacheTtlSetting getTtlEnvVar(const std::string& key, const CacheTtlSetting& fallback);
 };
 
 #endif // CONFIG_H
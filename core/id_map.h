@@ -0,0 +1,124 @@
+#ifndef ID_MAP_H
+#define ID_MAP_H
+
+#include <vector>
+#include <cstdint>
+#include <cstddef>
+#include <utility>
+
+// ---- Hash map open-addressing (linear probing) dengan key integer 64-bit.
+// ---- Dipakai untuk key gabungan dari SymbolId (lihat PackIdKey), tanpa alokasi string.
+// ---- TIDAK thread-safe: pemanggil yang pegang mutex. Pointer hasil find()
+// ---- tidak valid lagi setelah insert (bisa rehash) atau erase.
+template <class V>
+class IdMap {
+public:
+  static constexpr uint64_t kEmptyKey = ~0ull;
+
+  explicit IdMap(size_t initialCapacity = 64) {
+    size_t cap = 16;
+    while (cap < initialCapacity) cap <<= 1;
+    m_entries.resize(cap);
+  }
+
+  V* find(uint64_t key) {
+    size_t idx = indexOf(key);
+    return idx == npos ? nullptr : &m_entries[idx].value;
+  }
+
+  const V* find(uint64_t key) const {
+    size_t idx = indexOf(key);
+    return idx == npos ? nullptr : &m_entries[idx].value;
+  }
+
+  bool contains(uint64_t key) const { return indexOf(key) != npos; }
+
+  // Insert value default kalau key belum ada
+  V& operator[](uint64_t key) {
+    if ((m_size + 1) * 2 > m_entries.size()) grow();
+    size_t mask = m_entries.size() - 1;
+    size_t idx = hash(key) & mask;
+    while (m_entries[idx].key != kEmptyKey) {
+      if (m_entries[idx].key == key) return m_entries[idx].value;
+      idx = (idx + 1) & mask;
+    }
+    m_entries[idx].key = key;
+    m_entries[idx].value = V();
+    ++m_size;
+    return m_entries[idx].value;
+  }
+
+  bool erase(uint64_t key) {
+    size_t idx = indexOf(key);
+    if (idx == npos) return false;
+
+    // Backward-shift deletion: geser entry berikutnya supaya rantai probing tidak putus
+    size_t mask = m_entries.size() - 1;
+    size_t hole = idx;
+    size_t next = (hole + 1) & mask;
+    while (m_entries[next].key != kEmptyKey) {
+      size_t home = hash(m_entries[next].key) & mask;
+      if (((next - home) & mask) >= ((next - hole) & mask)) {
+        m_entries[hole] = std::move(m_entries[next]);
+        hole = next;
+      }
+      next = (next + 1) & mask;
+    }
+    m_entries[hole].key = kEmptyKey;
+    m_entries[hole].value = V();
+    --m_size;
+    return true;
+  }
+
+  size_t size() const { return m_size; }
+  bool empty() const { return m_size == 0; }
+
+  void clear() {
+    for (auto& e : m_entries) {
+      e.key = kEmptyKey;
+      e.value = V();
+    }
+    m_size = 0;
+  }
+
+private:
+  struct Entry {
+    uint64_t key = kEmptyKey;
+    V value = V();
+  };
+
+  static constexpr size_t npos = static_cast<size_t>(-1);
+
+  static size_t hash(uint64_t k) {
+    // Finalizer murmur3: sebar bit simbol (atas) dan sub-key (bawah)
+    k ^= k >> 33;
+    k *= 0xff51afd7ed558ccdULL;
+    k ^= k >> 33;
+    return static_cast<size_t>(k);
+  }
+
+  size_t indexOf(uint64_t key) const {
+    size_t mask = m_entries.size() - 1;
+    size_t idx = hash(key) & mask;
+    while (m_entries[idx].key != kEmptyKey) {
+      if (m_entries[idx].key == key) return idx;
+      idx = (idx + 1) & mask;
+    }
+    return npos;
+  }
+
+  void grow() {
+    std::vector<Entry> old;
+    old.swap(m_entries);
+    m_entries.resize(old.size() * 2);
+    m_size = 0;
+    for (auto& e : old) {
+      if (e.key != kEmptyKey) (*this)[e.key] = std::move(e.value);
+    }
+  }
+
+  std::vector<Entry> m_entries;
+  size_t m_size = 0;
+};
+
+#endif // ID_MAP_H
@@ -0,0 +1,57 @@
+#include "symbol_table.h"
+
+SymbolTable::SymbolTable()
+  : m_buckets(new std::atomic<uint32_t>[kBuckets]),
+    m_names(new std::string[kCapacity]) {
+  for (uint32_t i = 0; i < kBuckets; ++i) m_buckets[i].store(0, std::memory_order_relaxed);
+}
+
+// FNV-1a, cukup untuk ticker pendek
+uint32_t SymbolTable::hash(std::string_view s) {
+  uint32_t h = 2166136261u;
+  for (char c : s) {
+    h ^= static_cast<uint8_t>(c);
+    h *= 16777619u;
+  }
+  return h;
+}
+
+SymbolId SymbolTable::find(std::string_view name) const {
+  uint32_t idx = hash(name) & (kBuckets - 1);
+  for (;;) {
+    uint32_t slot = m_buckets[idx].load(std::memory_order_acquire);
+    if (slot == 0) return kNoSymbol;
+    if (m_names[slot - 1] == name) return slot - 1;
+    idx = (idx + 1) & (kBuckets - 1);
+  }
+}
+
+SymbolId SymbolTable::intern(std::string_view name) {
+  SymbolId id = find(name);
+  if (id != kNoSymbol) return id;
+
+  std::lock_guard<std::mutex> lock(m_writeMtx);
+  id = find(name);                                      // Keduluan writer lain?
+  if (id != kNoSymbol) return id;
+
+  uint32_t count = m_count.load(std::memory_order_relaxed);
+  if (count >= kCapacity) return kNoSymbol;
+
+  // Tulis nama dulu, baru publish bucket (release) -> reader tidak pernah lihat nama kosong
+  id = count;
+  m_names[id].assign(name.data(), name.size());
+
+  uint32_t idx = hash(name) & (kBuckets - 1);
+  while (m_buckets[idx].load(std::memory_order_relaxed) != 0) {
+    idx = (idx + 1) & (kBuckets - 1);
+  }
+  m_buckets[idx].store(id + 1, std::memory_order_release);
+  m_count.store(count + 1, std::memory_order_release);
+  return id;
+}
+
+const std::string& SymbolTable::name(SymbolId id) const {
+  static const std::string kEmpty;
+  if (id >= m_count.load(std::memory_order_acquire)) return kEmpty;
+  return m_names[id];
+}
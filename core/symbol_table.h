@@ -0,0 +1,60 @@
+#ifndef SYMBOL_TABLE_H
+#define SYMBOL_TABLE_H
+
+#include <string>
+#include <string_view>
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <cstdint>
+
+// ---- ID integer padat untuk string yang sering dipakai sebagai key
+// ---- (ticker, kode broker, tipe ownership). Sekali di-intern, ID tidak pernah berubah,
+// ---- jadi store & antrian bisa pakai array/hash integer, bukan std::string.
+using SymbolId = uint32_t;
+constexpr SymbolId kNoSymbol = 0xFFFFFFFFu;
+
+// Gabungkan dua ID jadi satu key 64-bit (misal: simbol + fitem_id / kode broker)
+inline uint64_t PackIdKey(SymbolId hi, uint32_t lo) {
+  return (static_cast<uint64_t>(hi) << 32) | lo;
+}
+
+class SymbolTable {
+public:
+  static constexpr uint32_t kCapacity = 16384;    // Maksimal string unik per sesi
+
+  // ---- Singleton Access
+  static SymbolTable& instance() {
+    static SymbolTable inst;
+    return inst;
+  }
+
+  // Lock-free. kNoSymbol kalau belum pernah di-intern.
+  SymbolId find(std::string_view name) const;
+
+  // Cari, atau buat ID baru (writer ambil mutex, jarang terjadi).
+  // kNoSymbol kalau tabel penuh.
+  SymbolId intern(std::string_view name);
+
+  // Lock-free. String kosong untuk ID yang tidak valid.
+  const std::string& name(SymbolId id) const;
+
+  uint32_t size() const { return m_count.load(std::memory_order_acquire); }
+
+private:
+  SymbolTable();
+
+  // ---- Disable Copy/Move
+  SymbolTable(const SymbolTable&) = delete;
+  SymbolTable& operator=(const SymbolTable&) = delete;
+
+  static constexpr uint32_t kBuckets = kCapacity * 2;   // Load factor maks 0.5 (open addressing)
+  static uint32_t hash(std::string_view s);
+
+  std::unique_ptr<std::atomic<uint32_t>[]> m_buckets;   // 0 = kosong, selain itu ID + 1
+  std::unique_ptr<std::string[]> m_names;               // Ditulis sekali sebelum ID di-publish
+  std::atomic<uint32_t> m_count{0};
+  std::mutex m_writeMtx;
+};
+
+#endif // SYMBOL_TABLE_H
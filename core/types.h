@@ -3,20 +3,6 @@
 
 #include <string>
 
-// ---- Struct for a single bar/candle (from historical API)
-// ---- Struct untuk satu bar/candle (dari API historis)
-struct Candle {
-  std::string date;
-  double open = 0;
-  double high = 0;
-  double low = 0;
-  double close = 0;
-  double volume = 0;
-  double frequency = 0;
-  double value = 0;
-  double netforeign = 0;
-};
-
 // ---- Struct untuk data quote terakhir dari API (saat market tutup)
 struct LatestQuote {
   std::string symbol;
@@ -0,0 +1,99 @@
+#include "bar_cache.h"
+#include "bar_file.h"
+#include <windows.h>
+#include <mutex>
+#include <ctime>
+#include <filesystem>
+
+namespace fs = std::filesystem;
+
+static std::mutex g_cacheDirMtx;
+static std::string g_cacheDir;
+
+static void LogCache(const std::string& msg) {
+  SYSTEMTIME t;
+  GetLocalTime(&t);
+  char buf[64];
+  sprintf_s(buf, "[%02d:%02d:%02d.%03d] ", t.wHour, t.wMinute, t.wSecond, t.wMilliseconds);
+  OutputDebugStringA((std::string(buf) + "[BarCache] " + msg + "\n").c_str());
+}
+
+// Ticker -> nama file yang unik & reversibel, juga di filesystem case-insensitive
+// (NTFS). Yang lolos apa adanya cuma A-Z, 0-9, '-' dan '.'; byte lain termasuk
+// huruf kecil, '_' dan '%' jadi %XX. "^JKSE" -> "%5EJKSE", "_JKSE" -> "%5FJKSE",
+// "bbca" -> "%62%62%63%61" (tidak bentrok dengan "BBCA"). Nama device Windows
+// (CON, NUL, COM1, ...) di-escape huruf pertamanya.
+static std::string FileNameFor(const std::string& symbol) {
+  static const char kHex[] = "0123456789ABCDEF";
+  std::string name;
+  name.reserve(symbol.size() + 4);
+  for (char ch : symbol) {
+    unsigned char c = static_cast<unsigned char>(ch);
+    bool ok = (c >= 'A' && c <= 'Z') || (c >= '0' && c <= '9') || c == '-' || c == '.';
+    if (ok) {
+      name.push_back(ch);
+    } else {
+      name.push_back('%');
+      name.push_back(kHex[c >> 4]);
+      name.push_back(kHex[c & 0x0F]);
+    }
+  }
+
+  std::string stem = name.substr(0, name.find('.'));
+  bool device = stem == "CON" || stem == "PRN" || stem == "AUX" || stem == "NUL" ||
+                (stem.size() == 4 && (stem.compare(0, 3, "COM") == 0 || stem.compare(0, 3, "LPT") == 0) &&
+                 stem[3] >= '1' && stem[3] <= '9');
+  if (device) {
+    unsigned char c = static_cast<unsigned char>(name[0]);
+    name.replace(0, 1, std::string{ '%', kHex[c >> 4], kHex[c & 0x0F] });
+  }
+  return name + ".vbc";
+}
+
+static std::string PathFor(const std::string& symbol) {
+  std::lock_guard<std::mutex> lock(g_cacheDirMtx);
+  if (g_cacheDir.empty()) return "";
+  return (fs::path(g_cacheDir) / FileNameFor(symbol)).string();
+}
+
+void BarCache::setDirectory(const std::string& dir) {
+  std::error_code ec;
+  if (!dir.empty()) fs::create_directories(dir, ec);
+
+  std::lock_guard<std::mutex> lock(g_cacheDirMtx);
+  if (ec) {
+    LogCache("ERROR: Cannot create cache dir " + dir + " (" + ec.message() + "). Disk cache disabled.");
+    g_cacheDir.clear();
+    return;
+  }
+  g_cacheDir = dir;
+  LogCache(dir.empty() ? "Disk cache disabled." : "Disk cache at " + dir);
+}
+
+bool BarCache::enabled() {
+  std::lock_guard<std::mutex> lock(g_cacheDirMtx);
+  return !g_cacheDir.empty();
+}
+
+bool BarCache::load(const std::string& symbol, std::vector<Quotation>& out) {
+  std::string path = PathFor(symbol);
+  if (path.empty()) return false;
+
+  BarFileView view;
+  if (!view.open(path, sizeof(Quotation))) return false;
+
+  const Quotation* first = static_cast<const Quotation*>(view.records());
+  out.assign(first, first + view.count());     // Layout sama -> bulk copy dari mapping
+  return true;
+}
+
+bool BarCache::save(const std::string& symbol, const std::vector<Quotation>& bars) {
+  std::string path = PathFor(symbol);
+  if (path.empty()) return false;
+
+  // Penulisan simbol yang sama diserialisasi pemanggil (fetchAndCache), bersama
+  // pengambilan snapshot-nya; simbol berbeda punya .tmp sendiri
+  bool ok = WriteBarFile(path, bars.data(), bars.size(), sizeof(Quotation), static_cast<uint64_t>(std::time(nullptr)));
+  if (!ok) LogCache("ERROR: Failed to write " + path);
+  return ok;
+}
@@ -0,0 +1,24 @@
+#ifndef BAR_CACHE_H
+#define BAR_CACHE_H
+
+#include <string>
+#include <vector>
+#include "bar_series.h"
+
+// ---- Cache bar EOD di disk, satu file per simbol (format: lihat bar_file.h).
+// ---- File di-map saat akses pertama lalu di-bulk copy ke DataStore, jadi
+// ---- setelah restart AmiBroker cukup fetch bar sejak tanggal cache terakhir.
+namespace BarCache {
+  // Set folder cache. String kosong = cache dimatikan.
+  void setDirectory(const std::string& dir);
+  bool enabled();
+
+  // Load semua bar simbol dari disk. Return false kalau belum ada / file tidak valid.
+  bool load(const std::string& symbol, std::vector<Quotation>& out);
+
+  // Simpan seluruh seri (menimpa file lama secara atomik). Tidak mengunci:
+  // pemanggil wajib menyerialisasi save untuk simbol yang sama.
+  bool save(const std::string& symbol, const std::vector<Quotation>& bars);
+}
+
+#endif // BAR_CACHE_H
@@ -0,0 +1,133 @@
+#include "bar_file.h"
+#include <cstdio>
+#include <fstream>
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+BarFileView::~BarFileView() {
+  close();
+}
+
+bool BarFileView::open(const std::string& path, uint32_t expectedRecordSize) {
+  close();
+
+#ifdef _WIN32
+  HANDLE hFile = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ | FILE_SHARE_DELETE, NULL,
+                             OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, NULL);
+  if (hFile == INVALID_HANDLE_VALUE) return false;
+  m_file = hFile;
+
+  LARGE_INTEGER fileSize;
+  if (!GetFileSizeEx(hFile, &fileSize) || fileSize.QuadPart < (LONGLONG)sizeof(BarFileHeader)) {
+    close();
+    return false;
+  }
+  m_size = static_cast<size_t>(fileSize.QuadPart);
+
+  HANDLE hMap = CreateFileMappingA(hFile, NULL, PAGE_READONLY, 0, 0, NULL);
+  if (!hMap) {
+    close();
+    return false;
+  }
+  m_mapping = hMap;
+
+  m_base = MapViewOfFile(hMap, FILE_MAP_READ, 0, 0, 0);
+  if (!m_base) {
+    close();
+    return false;
+  }
+#else
+  int fd = ::open(path.c_str(), O_RDONLY);
+  if (fd < 0) return false;
+  m_fd = fd;
+
+  struct stat st;
+  if (fstat(fd, &st) != 0 || st.st_size < (off_t)sizeof(BarFileHeader)) {
+    close();
+    return false;
+  }
+  m_size = static_cast<size_t>(st.st_size);
+
+  void* base = mmap(nullptr, m_size, PROT_READ, MAP_PRIVATE, fd, 0);
+  if (base == MAP_FAILED) {
+    close();
+    return false;
+  }
+  m_base = base;
+#endif
+
+  // ---- Validasi header
+  const BarFileHeader* hdr = static_cast<const BarFileHeader*>(m_base);
+  if (hdr->magic != BAR_FILE_MAGIC || hdr->version != BAR_FILE_VERSION || hdr->recordSize != expectedRecordSize) {
+    close();
+    return false;
+  }
+  if (hdr->count > (m_size - sizeof(BarFileHeader)) / expectedRecordSize ||
+      sizeof(BarFileHeader) + hdr->count * expectedRecordSize != m_size) {
+    close();    // Ukuran tidak cocok: file terpotong / korup
+    return false;
+  }
+
+  m_header = hdr;
+  return true;
+}
+
+void BarFileView::close() {
+  m_header = nullptr;
+#ifdef _WIN32
+  if (m_base) UnmapViewOfFile(m_base);
+  if (m_mapping) CloseHandle((HANDLE)m_mapping);
+  if (m_file) CloseHandle((HANDLE)m_file);
+  m_mapping = nullptr;
+  m_file = nullptr;
+#else
+  if (m_base) munmap(m_base, m_size);
+  if (m_fd >= 0) ::close(m_fd);
+  m_fd = -1;
+#endif
+  m_base = nullptr;
+  m_size = 0;
+}
+
+bool WriteBarFile(const std::string& path, const void* records, size_t count, uint32_t recordSize, uint64_t savedAt) {
+  BarFileHeader hdr = {};
+  hdr.magic = BAR_FILE_MAGIC;
+  hdr.version = BAR_FILE_VERSION;
+  hdr.recordSize = recordSize;
+  hdr.count = count;
+  hdr.savedAt = savedAt;
+
+  std::string tmpPath = path + ".tmp";
+  {
+    std::ofstream out(tmpPath, std::ios::binary | std::ios::trunc);
+    if (!out) return false;
+    out.write(reinterpret_cast<const char*>(&hdr), sizeof(hdr));
+    if (count > 0) out.write(static_cast<const char*>(records), static_cast<std::streamsize>(count * recordSize));
+    if (!out) {
+      out.close();
+      std::remove(tmpPath.c_str());
+      return false;
+    }
+  }
+
+#ifdef _WIN32
+  // Ganti file lama secara atomik (view yang masih ter-map di proses ini tetap valid)
+  if (!MoveFileExA(tmpPath.c_str(), path.c_str(), MOVEFILE_REPLACE_EXISTING)) {
+    DeleteFileA(tmpPath.c_str());
+    return false;
+  }
+#else
+  if (std::rename(tmpPath.c_str(), path.c_str()) != 0) {
+    std::remove(tmpPath.c_str());
+    return false;
+  }
+#endif
+  return true;
+}
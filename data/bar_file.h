@@ -0,0 +1,60 @@
+#ifndef BAR_FILE_H
+#define BAR_FILE_H
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+// ---- Format file cache bar (portable, tidak tergantung windows.h / plugin.h)
+//
+//   [BarFileHeader 32 byte][record x count]
+//
+// Record disimpan mentah dalam layout aslinya (untuk plugin: Quotation 40 byte),
+// jadi setelah di-map cukup bulk copy. recordSize dicek saat buka supaya file
+// dari layout lain tidak salah dibaca.
+struct BarFileHeader {
+  uint32_t magic;         // BAR_FILE_MAGIC
+  uint32_t version;       // BAR_FILE_VERSION
+  uint32_t recordSize;    // sizeof(record)
+  uint32_t reserved;
+  uint64_t count;         // jumlah record
+  uint64_t savedAt;       // Unix timestamp (detik) saat ditulis
+};
+static_assert(sizeof(BarFileHeader) == 32, "BarFileHeader harus 32 byte");
+
+#define BAR_FILE_MAGIC    0x31434256u   // "VBC1" little-endian
+#define BAR_FILE_VERSION  1u
+
+// ---- Read-only memory mapping (Win32: CreateFileMapping, POSIX: mmap)
+class BarFileView {
+public:
+  BarFileView() = default;
+  ~BarFileView();
+
+  BarFileView(const BarFileView&) = delete;
+  BarFileView& operator=(const BarFileView&) = delete;
+
+  // Map file dan validasi header. Return false kalau file tidak ada / rusak / recordSize beda.
+  bool open(const std::string& path, uint32_t expectedRecordSize);
+  void close();
+
+  const BarFileHeader* header() const { return m_header; }
+  const void* records() const { return m_header ? reinterpret_cast<const uint8_t*>(m_header) + sizeof(BarFileHeader) : nullptr; }
+  size_t count() const { return m_header ? static_cast<size_t>(m_header->count) : 0; }
+
+private:
+  const BarFileHeader* m_header = nullptr;
+  void* m_base = nullptr;
+  size_t m_size = 0;
+#ifdef _WIN32
+  void* m_file = nullptr;     // HANDLE
+  void* m_mapping = nullptr;  // HANDLE
+#else
+  int m_fd = -1;
+#endif
+};
+
+// Tulis file secara atomik (tulis ke .tmp lalu rename), supaya reader tidak pernah lihat file setengah jadi
+bool WriteBarFile(const std::string& path, const void* records, size_t count, uint32_t recordSize, uint64_t savedAt);
+
+#endif // BAR_FILE_H
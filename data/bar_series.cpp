@@ -0,0 +1,204 @@
+#include "bar_series.h"
+#include <cstdio>
+#include <algorithm>
+#include <atomic>
+#include <ctime>
+#include <cstring>
+#include "civil_date.h"
+
+DATE_TIME_INT PackEodDate(int year, int month, int day) {
+  AmiDate d;
+  d.Date = 0;
+  d.PackDate.Year = year;
+  d.PackDate.Month = month;
+  d.PackDate.Day = day;
+  d.PackDate.Hour = DATE_EOD_HOURS;
+  d.PackDate.Minute = DATE_EOD_MINUTES;
+  return d.Date;
+}
+
+DATE_TIME_INT NormalizeEodDate(DATE_TIME_INT date) {
+  AmiDate d;
+  d.Date = date;
+  return PackEodDate(d.PackDate.Year, d.PackDate.Month, d.PackDate.Day);
+}
+
+int32_t EodDateToDays(DATE_TIME_INT date) {
+  AmiDate d;
+  d.Date = date;
+  return CivilDate::DaysFromCivil(d.PackDate.Year, d.PackDate.Month, d.PackDate.Day);
+}
+
+DATE_TIME_INT DaysToEodDate(int32_t days) {
+  CivilDate::Ymd ymd = CivilDate::CivilFromDays(days);
+  return PackEodDate(ymd.year, ymd.month, ymd.day);
+}
+
+int64_t EodDateToUnix(DATE_TIME_INT date) {
+  return CivilDate::UnixFromDays(EodDateToDays(date));
+}
+
+bool ParseEodDate(std::string_view s, DATE_TIME_INT& out) {
+  CivilDate::Ymd ymd{ 0, 0, 0 };
+  if (!CivilDate::ParseIsoYmd(s, ymd)) return false;
+  out = PackEodDate(ymd.year, ymd.month, ymd.day);
+  return true;
+}
+
+static bool BarDateLess(const Quotation& a, const Quotation& b) {
+  return a.DateTime.Date < b.DateTime.Date;
+}
+
+void SpliceBars(const std::vector<Quotation>& base, const std::vector<Quotation>& deltaIn, std::vector<Quotation>& out) {
+  out.clear();
+
+  // Jaga-jaga kalau delta dari API tidak urut (normalnya sudah urut, cek O(k))
+  std::vector<Quotation> sortedDelta;
+  const std::vector<Quotation>* deltaPtr = &deltaIn;
+  if (!std::is_sorted(deltaIn.begin(), deltaIn.end(), BarDateLess)) {
+    sortedDelta = deltaIn;
+    std::stable_sort(sortedDelta.begin(), sortedDelta.end(), BarDateLess);
+    deltaPtr = &sortedDelta;
+  }
+  const std::vector<Quotation>& delta = *deltaPtr;
+
+  if (delta.empty()) {
+    out = base;
+    return;
+  }
+
+  // Titik splice: bar pertama di base yang tanggalnya >= awal delta
+  auto splice = std::lower_bound(base.begin(), base.end(), delta.front(), BarDateLess);
+  out.reserve(base.size() + delta.size());
+  out.insert(out.end(), base.begin(), splice);
+
+  // Merge ekor base (biasanya cuma beberapa bar) dengan delta.
+  // Bar base dengan tanggal sama di-skip (ditimpa delta); duplikat di delta: yang terakhir menang.
+  const size_t prefixLen = out.size();
+  auto pushDelta = [&](const Quotation& q) {
+    if (out.size() > prefixLen && out.back().DateTime.Date == q.DateTime.Date) out.back() = q;
+    else out.push_back(q);
+  };
+
+  auto b = splice;
+  auto d = delta.begin();
+  while (b != base.end() && d != delta.end()) {
+    if (b->DateTime.Date < d->DateTime.Date) {
+      out.push_back(*b++);
+    } else {
+      if (b->DateTime.Date == d->DateTime.Date) ++b;
+      pushDelta(*d++);
+    }
+  }
+  out.insert(out.end(), b, base.end());
+  while (d != delta.end()) pushDelta(*d++);
+}
+
+int MergeBarsInPlace(Quotation* dst, int n, int cap, const Quotation* src, size_t m) {
+  if (m == 0 || cap <= 0) return n;
+  const Quotation* srcEnd = src + m;
+
+  // Prefix dst sebelum tanggal pertama src tidak tersentuh merge
+  int prefix = static_cast<int>(std::lower_bound(dst, dst + n, src[0], BarDateLess) - dst);
+
+  // ---- 1. Hitung ukuran gabungan (tanggal unik) dari ekor dst + src
+  size_t total = prefix;
+  {
+    int i = prefix;
+    const Quotation* j = src;
+    while (i < n && j != srcEnd) {
+      if (dst[i].DateTime.Date < j->DateTime.Date) ++i;
+      else {
+        if (dst[i].DateTime.Date == j->DateTime.Date) ++i;
+        ++j;
+      }
+      ++total;
+    }
+    total += (n - i) + (srcEnd - j);
+  }
+
+  // ---- 2. Kelebihan kapasitas: buang bar paling lama dulu. Bagian dst yang
+  // tetap dipakai di-memmove ke depan sebelum merge, supaya merge mundur di
+  // bawah tidak pernah menimpa bar dst yang belum dibaca.
+  if (total > static_cast<size_t>(cap)) {
+    size_t drop = total - cap;
+    int i = 0;
+    while (drop > 0) {
+      if (i < n && (src == srcEnd || dst[i].DateTime.Date < src->DateTime.Date)) ++i;
+      else {
+        if (i < n && dst[i].DateTime.Date == src->DateTime.Date) ++i;
+        ++src;
+      }
+      --drop;
+    }
+    if (i > 0) {
+      memmove(dst, dst + i, (n - i) * sizeof(Quotation));
+      n -= i;
+    }
+    total = cap;
+  }
+
+  // ---- 3. Merge mundur dari ujung. Sisa output selalu >= sisa dst yang belum
+  // dibaca, jadi posisi tulis k tidak pernah mendahului posisi baca i.
+  int i = n - 1;
+  const Quotation* j = srcEnd;
+  int k = static_cast<int>(total) - 1;
+  while (j != src) {
+    const Quotation& s = *(j - 1);
+    if (i >= 0 && dst[i].DateTime.Date > s.DateTime.Date) {
+      dst[k--] = dst[i--];
+    } else {
+      if (i >= 0 && dst[i].DateTime.Date == s.DateTime.Date) --i;
+      dst[k--] = s;
+      --j;
+    }
+  }
+  // Sisa dst[0..i] sudah di posisi akhirnya (k == i)
+  return static_cast<int>(total);
+}
+
+DATE_TIME_INT TodayEodDate() {
+  static std::atomic<DATE_TIME_INT> s_today{0};
+  static std::atomic<long long> s_validUntil{0};    // time_t tengah malam berikutnya
+
+  std::time_t now = std::time(nullptr);
+  if (now < s_validUntil.load(std::memory_order_acquire)) {
+    return s_today.load(std::memory_order_relaxed);
+  }
+
+  int32_t days = CivilDate::DaysFromUnix(static_cast<int64_t>(now));
+  DATE_TIME_INT today = DaysToEodDate(days);
+
+  s_today.store(today, std::memory_order_relaxed);
+  s_validUntil.store(static_cast<long long>(CivilDate::UnixFromDays(days + 1)), std::memory_order_release);
+  return today;
+}
+
+// Bit di PackDate.Reserved penanda bar overlay live (AmiBroker tidak memakainya)
+static constexpr unsigned kLiveBarMark = 1;
+
+Quotation BuildLiveBar(const Quotation* lastStored, const LiveQuote& live, DATE_TIME_INT today) {
+  Quotation bar;
+  if (lastStored && lastStored->DateTime.Date == today) {
+    bar = *lastStored;
+    bar.Price = static_cast<float>(live.lastprice);
+    bar.High = std::max(bar.High, static_cast<float>(live.high));
+    bar.Low = std::min(bar.Low, static_cast<float>(live.low));
+  } else {
+    bar.DateTime.Date = today;
+    bar.Open = static_cast<float>(live.open);
+    bar.High = static_cast<float>(live.high);
+    bar.Low = static_cast<float>(live.low);
+    bar.Price = static_cast<float>(live.lastprice);
+  }
+  bar.Volume = static_cast<float>(live.volume);
+  bar.AuxData1 = static_cast<float>(live.value);
+  bar.OpenInterest = static_cast<float>(live.frequency);
+  bar.AuxData2 = static_cast<float>(live.netforeign);
+  bar.DateTime.PackDate.Reserved |= kLiveBarMark;
+  return bar;
+}
+
+bool IsLiveBar(const Quotation& bar) {
+  return (bar.DateTime.PackDate.Reserved & kLiveBarMark) != 0;
+}
@@ -0,0 +1,62 @@
+#ifndef BAR_SERIES_H
+#define BAR_SERIES_H
+
+#include <cstdint>
+#include <string_view>
+#include <vector>
+#include "plugin.h"       // Struct Quotation, AmiDate
+#include "types.h"        // Struct LiveQuote
+
+// ---- Seri bar EOD untuk satu simbol.
+// ---- Tiap baris sudah dalam layout Quotation (packed AmiDate + 8 float),
+// ---- jadi copy-out ke pQuotes AmiBroker cukup satu memcpy tanpa parsing tanggal.
+struct BarSeries {
+  std::vector<Quotation> bars;
+  long long fetchedAtMs = 0;    // steady_clock (ms) saat terakhir divalidasi ke server / kalender
+};
+
+// Bikin packed date EOD (Hour/Minute = marker EOD AmiBroker, bit lain nol)
+DATE_TIME_INT PackEodDate(int year, int month, int day);
+
+// Normalisasi tanggal dari AmiBroker supaya bisa dibandingkan langsung sebagai integer
+DATE_TIME_INT NormalizeEodDate(DATE_TIME_INT date);
+
+// Konversi packed date EOD <-> epoch day (hari sejak 1970-01-01, lihat civil_date.h)
+int32_t EodDateToDays(DATE_TIME_INT date);
+DATE_TIME_INT DaysToEodDate(int32_t days);
+
+// Packed date -> Unix detik 00:00 waktu bursa (CivilDate::kExchangeUtcOffsetSec).
+// Jam di packed date diabaikan; dipakai untuk mencocokkan bar dengan DataPoint::ts.
+int64_t EodDateToUnix(DATE_TIME_INT date);
+
+// Parse "YYYY-MM-DD" (format tetap 10 karakter, tanpa sscanf / alokasi) ke
+// packed date EOD. Return false kalau format atau range bulan/hari salah.
+bool ParseEodDate(std::string_view date_str, DATE_TIME_INT& out);
+
+// Gabungkan dua seri yang sudah urut tanggal (ascending). Bar di 'delta' menang
+// kalau tanggalnya sama. Prefix 'base' sebelum tanggal pertama delta di-copy
+// sekaligus, jadi biayanya O(n) copy + O(k) merge untuk delta kecil di ekor.
+void SpliceBars(const std::vector<Quotation>& base, const std::vector<Quotation>& delta, std::vector<Quotation>& out);
+
+// Versi in-place untuk buffer AmiBroker: gabungkan 'src' ke dst[0..n) dengan
+// kapasitas 'cap', tanpa alokasi. dst harus sudah urut & ternormalisasi
+// (NormalizeEodDate). Bar src menang kalau tanggalnya sama; kalau hasil gabungan
+// melebihi cap, bar paling lama yang dibuang. Return jumlah bar hasil.
+int MergeBarsInPlace(Quotation* dst, int n, int cap, const Quotation* src, size_t m);
+
+// Tanggal EOD hari ini (waktu bursa). Di-cache sampai tengah malam berikutnya,
+// jadi pemanggilan per GetQuotesEx cuma baca jam + satu perbandingan.
+DATE_TIME_INT TodayEodDate();
+
+// Bangun bar virtual hari ini dari live quote. Kalau 'lastStored' adalah bar hari ini,
+// harga/volume di-overlay di atasnya (high/low digabung), selain itu jadi bar baru.
+// Tidak ada yang ditulis ke store: dipakai saat copy-out saja. Bar hasilnya
+// ditandai (IsLiveBar) karena AmiBroker menyimpannya di buffer miliknya.
+Quotation BuildLiveBar(const Quotation* lastStored, const LiveQuote& live, DATE_TIME_INT today);
+
+// true kalau bar berasal dari BuildLiveBar (bit Reserved packed date). Bar seperti
+// ini cuma perkiraan intraday: planner harus menganggapnya belum ada. Tanda
+// hilang begitu tanggalnya dinormalisasi (NormalizeEodDate).
+bool IsLiveBar(const Quotation& bar);
+
+#endif // BAR_SERIES_H
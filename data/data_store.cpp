@@ -1,65 +1,95 @@
 #include "data_store.h"
 #include <algorithm>
-#include <map>
 #include <chrono>
-#include <sstream>
-#include <iomanip>
 #include <mutex>
 
-void DataStore::setHistorical(const std::string& symbol, const std::vector<Candle>& candles) {
-  std::lock_guard<std::mutex> lock(m_mtx);
-  m_historicalData[symbol] = candles;
+// Stempel BarSeries::fetchedAtMs (steady_clock, sama dengan pembacanya di bridge)
+static long long SteadyNowMs() {
+  return std::chrono::duration_cast<std::chrono::milliseconds>(
+      std::chrono::steady_clock::now().time_since_epoch()).count();
 }
 
-void DataStore::mergeHistorical(const std::string& symbol, const std::vector<Candle>& new_candles) {
-  std::lock_guard<std::mutex> lock(m_mtx);
+DataStore::DataStore() : m_slots(new SymbolSlot[SymbolTable::kCapacity]) {}
 
-  if (new_candles.empty()) {
-    return; // Tidak ada yang perlu di-merge
-  }
+// ---- Lookup slot tanpa lock: index langsung ke array
+DataStore::SymbolSlot* DataStore::slotFor(SymbolId id) const {
+  if (id >= SymbolTable::kCapacity) return nullptr;
+  return &m_slots[id];
+}
 
-  // Gunakan std::map untuk menjaga urutan tanggal dan update otomatis
-  std::map<std::string, Candle> merged_map;
+void DataStore::setHistorical(SymbolId symbol, const std::vector<Quotation>& bars) {
+  SymbolSlot* slot = slotFor(symbol);
+  if (!slot) return;
+  auto series = std::make_shared<BarSeries>();
+  series->bars = bars;
+  series->fetchedAtMs = SteadyNowMs();
 
-  // Selalu ambil referensi ke vector (akan buat entry kosong bila belum ada)
-  auto& existingVec = m_historicalData[symbol];
-  for (const auto& old_candle : existingVec) {
-    merged_map[old_candle.date] = old_candle;
-  }
+  std::lock_guard<std::mutex> lock(m_histMtx);
+  std::atomic_store(&slot->historical, std::shared_ptr<const BarSeries>(std::move(series)));
+}
 
-  for (const auto& new_candle : new_candles) {
-    merged_map[new_candle.date] = new_candle;
-  }
+std::shared_ptr<const BarSeries> DataStore::initHistorical(SymbolId symbol, std::vector<Quotation>&& bars) {
+  SymbolSlot* slot = slotFor(symbol);
+  if (!slot) return nullptr;
 
-  std::vector<Candle> final_candles;
-  final_candles.reserve(merged_map.size());
-  for (const auto& pair : merged_map) {
-    final_candles.push_back(pair.second);
-  }
+  std::lock_guard<std::mutex> lock(m_histMtx);
+  // Jangan timpa hasil fetch yang mungkin sudah masuk dari thread lain
+  if (auto existing = std::atomic_load(&slot->historical)) return existing;
 
-  m_historicalData[symbol] = final_candles;
+  auto series = std::make_shared<BarSeries>();
+  series->bars = std::move(bars);
+  series->fetchedAtMs = SteadyNowMs();    // Disk cache langsung dicek ke kalender (GapPlanner)
+  std::shared_ptr<const BarSeries> published(std::move(series));
+  std::atomic_store(&slot->historical, published);
+  return published;
 }
 
-std::vector<Candle> DataStore::getHistorical(const std::string& symbol) {
-  std::lock_guard<std::mutex> lock(m_mtx);
-  if (m_historicalData.count(symbol)) {
-    return m_historicalData[symbol];
+void DataStore::mergeHistorical(SymbolId symbol, const std::vector<Quotation>& new_bars) {
+  if (new_bars.empty()) {
+    return; // Tidak ada yang perlu di-merge
   }
-  return {};
+
+  SymbolSlot* slot = slotFor(symbol);
+  if (!slot) return;
+  std::lock_guard<std::mutex> lock(m_histMtx);
+
+  // Snapshot lama tetap utuh untuk reader yang masih pegang, jadi hasil splice
+  // ditulis ke series baru: prefix di-copy sekaligus, ekor yang overlap ditimpa,
+  // bar baru di-append. Tidak ada map/alokasi per bar.
+  auto existing = std::atomic_load(&slot->historical);
+  auto merged = std::make_shared<BarSeries>();
+  static const std::vector<Quotation> kEmpty;
+  SpliceBars(existing ? existing->bars : kEmpty, new_bars, merged->bars);
+  merged->fetchedAtMs = SteadyNowMs();
+
+  std::atomic_store(&slot->historical, std::shared_ptr<const BarSeries>(std::move(merged)));
 }
 
-bool DataStore::hasHistorical(const std::string& symbol) {
-  std::lock_guard<std::mutex> lock(m_mtx);
-  return m_historicalData.count(symbol) > 0;
+std::shared_ptr<const BarSeries> DataStore::getHistorical(SymbolId symbol) const {
+  SymbolSlot* slot = slotFor(symbol);
+  if (!slot) return nullptr;
+  return std::atomic_load(&slot->historical);
 }
 
-void DataStore::updateLiveQuote(const StockFeed& feed) {
-  if (!feed.has_stock_data) return;
+bool DataStore::hasHistorical(SymbolId symbol) const {
+  SymbolSlot* slot = slotFor(symbol);
+  return slot && std::atomic_load(&slot->historical) != nullptr;
+}
+
+SymbolId DataStore::updateLiveQuote(const StockFeed& feed) {
+  if (!feed.has_stock_data) return kNoSymbol;
   const auto& s = feed.stock_data;
   std::string symbol = s.symbol;
 
-  std::lock_guard<std::mutex> lock(m_mtx);
-  LiveQuote& q = m_liveQuotes[symbol];
+  SymbolId id = SymbolTable::instance().intern(symbol);
+  SymbolSlot* slot = slotFor(id);
+  if (!slot) return kNoSymbol;
+  std::lock_guard<std::mutex> lock(m_liveMtx);
+
+  // Copy-on-write: mulai dari snapshot sebelumnya (change tidak selalu dikirim)
+  auto prev = std::atomic_load(&slot->live);
+  auto next = prev ? std::make_shared<LiveQuote>(*prev) : std::make_shared<LiveQuote>();
+  LiveQuote& q = *next;
 
   q.symbol = symbol;
   q.lastprice = s.close;
@@ -79,55 +109,13 @@ void DataStore::updateLiveQuote(const StockFeed& feed) {
   }
 
   q.previous = s.close - q.changeValue;
-}
 
-LiveQuote DataStore::getLiveQuote(const std::string& symbol) {
-  std::lock_guard<std::mutex> lock(m_mtx);
-  if (m_liveQuotes.count(symbol)) {
-    return m_liveQuotes[symbol];
-  }
-  return {};
+  std::atomic_store(&slot->live, std::shared_ptr<const LiveQuote>(std::move(next)));
+  return id;
 }
 
-void DataStore::mergeLiveToHistorical(const std::string& symbol) {
-  std::lock_guard<std::mutex> lock(m_mtx);
-
-  if (!m_liveQuotes.count(symbol)) {
-    return;
-  }
-
-  auto& candles = m_historicalData[symbol]; // otomatis buat entry kosong
-  auto& live = m_liveQuotes.at(symbol);
-
-  auto now = std::chrono::system_clock::now();
-  auto in_time_t = std::chrono::system_clock::to_time_t(now);
-  std::stringstream ss;
-  std::tm buf;
-  localtime_s(&buf, &in_time_t);
-  ss << std::put_time(&buf, "%Y-%m-%d");
-  std::string today_date_str = ss.str();
-
-  if (!candles.empty() && candles.back().date == today_date_str) {
-    Candle& lastCandle = candles.back();
-    lastCandle.close = live.lastprice;
-    lastCandle.high = std::max(lastCandle.high, live.high);
-    lastCandle.low = std::min(lastCandle.low, live.low);
-    lastCandle.volume = live.volume;
-    lastCandle.value = live.value;
-    lastCandle.frequency = live.frequency;
-    lastCandle.netforeign = live.netforeign;
-  } else {
-    Candle newCandle;
-    newCandle.date = today_date_str;
-    newCandle.open = live.open;
-    newCandle.high = live.high;
-    newCandle.low = live.low;
-    newCandle.close = live.lastprice;
-    newCandle.volume = live.volume;
-    newCandle.value = live.value;
-    newCandle.frequency = live.frequency;
-    newCandle.netforeign = live.netforeign;
-    candles.push_back(newCandle);
-  }
+std::shared_ptr<const LiveQuote> DataStore::getLiveQuote(SymbolId symbol) const {
+  SymbolSlot* slot = slotFor(symbol);
+  if (!slot) return nullptr;
+  return std::atomic_load(&slot->live);
 }
-
@@ -3,35 +3,57 @@
 
 #include <string>
 #include <vector>
-#include <map>
+#include <memory>
 #include <mutex>
 #include "types.h"
+#include "bar_series.h"
+#include "symbol_table.h"
 #include "feed.pb.h" // Diperlukan untuk StockFeed
 
+// ---- DataStore dengan snapshot immutable per simbol (RCU style).
+// ---- Reader (thread AmiBroker) cuma atomic_load shared_ptr, tidak pernah ambil mutex.
+// ---- Writer (worker fetch / callback WS) bikin snapshot baru lalu publish atomik.
+// ---- Slot disimpan di array flat, index = SymbolId (lihat symbol_table.h).
 class DataStore {
 private:
-  std::map<std::string, std::vector<Candle>> m_historicalData;
-  std::map<std::string, LiveQuote> m_liveQuotes;
-  std::mutex m_mtx;
+  struct SymbolSlot {
+    std::shared_ptr<const BarSeries> historical;    // Akses via std::atomic_load/atomic_store
+    std::shared_ptr<const LiveQuote> live;          // Akses via std::atomic_load/atomic_store
+  };
+
+  std::unique_ptr<SymbolSlot[]> m_slots;            // Kapasitas = SymbolTable::kCapacity
+
+  // Mutex khusus writer, reader tidak pernah menyentuh ini
+  std::mutex m_histMtx;       // Serialisasi writer data historis
+  std::mutex m_liveMtx;       // Serialisasi writer live quote
+
+  SymbolSlot* slotFor(SymbolId id) const;
 
 public:
+  DataStore();
+
   // Untuk data historis dari API
-  void setHistorical(const std::string& symbol, const std::vector<Candle>& candles);
+  void setHistorical(SymbolId symbol, const std::vector<Quotation>& bars);
+
+  // Publish seri awal hanya kalau slot masih kosong (akses pertama per sesi).
+  // Return snapshot yang berlaku: milik pemanggil, atau yang lebih dulu ada.
+  std::shared_ptr<const BarSeries> initHistorical(SymbolId symbol, std::vector<Quotation>&& bars);
 
   // Fungsi 'smart' untuk menggabungkan data baru dengan cache yang ada
-  void mergeHistorical(const std::string& symbol, const std::vector<Candle>& new_candles);
+  void mergeHistorical(SymbolId symbol, const std::vector<Quotation>& new_bars);
 
-  std::vector<Candle> getHistorical(const std::string& symbol);
-  bool hasHistorical(const std::string& symbol);
+  // View read-only yang di-share (reference counted), tanpa copy vector.
+  // nullptr = simbol belum pernah di-cache.
+  std::shared_ptr<const BarSeries> getHistorical(SymbolId symbol) const;
+  bool hasHistorical(SymbolId symbol) const;
 
   // Untuk data live dari WebSocket
-  void updateLiveQuote(const StockFeed& feed);
-  LiveQuote getLiveQuote(const std::string& symbol);
-
-  // Untuk menggabungkan data live ke bar historis terakhir
-  void mergeLiveToHistorical(const std::string& symbol);
+  SymbolId updateLiveQuote(const StockFeed& feed);     // Return simbol yang berubah (kNoSymbol = diabaikan)
+  std::shared_ptr<const LiveQuote> getLiveQuote(SymbolId symbol) const;   // nullptr kalau belum ada
+  // Catatan: live quote TIDAK pernah ditulis ke historis. Bar hari ini di-overlay
+  // sebagai bar virtual saat copy-out (lihat BuildLiveBar di bar_series.h).
 };
 
 extern DataStore gDataStore;
 
-#endif // DATA_STORE_H
\ No newline at end of file
+#endif // DATA_STORE_H
@@ -0,0 +1,90 @@
+#include "gap_planner.h"
+#include <algorithm>
+#include <iterator>
+#include "bar_series.h"
+#include "civil_date.h"
+
+using CivilDate::DaysFromCivil;
+using CivilDate::WeekdaysInRange;
+
+// ---- Libur bursa IDX yang jatuh di hari kerja (libur nasional + cuti bersama
+// + penutupan akhir tahun), urut. Tanggal yang tidak ada di sini dianggap hari
+// bursa; libur yang terlewat cuma berarti satu request yang hasilnya kosong.
+static constexpr int32_t kExchangeHolidays[] = {
+  // 2023
+  DaysFromCivil(2023, 1, 23), DaysFromCivil(2023, 3, 22), DaysFromCivil(2023, 3, 23),
+  DaysFromCivil(2023, 4, 7), DaysFromCivil(2023, 4, 19), DaysFromCivil(2023, 4, 20),
+  DaysFromCivil(2023, 4, 21), DaysFromCivil(2023, 4, 24), DaysFromCivil(2023, 4, 25),
+  DaysFromCivil(2023, 5, 1), DaysFromCivil(2023, 5, 18), DaysFromCivil(2023, 6, 1),
+  DaysFromCivil(2023, 6, 2), DaysFromCivil(2023, 6, 29), DaysFromCivil(2023, 7, 19),
+  DaysFromCivil(2023, 8, 17), DaysFromCivil(2023, 9, 28), DaysFromCivil(2023, 12, 25),
+  DaysFromCivil(2023, 12, 26), DaysFromCivil(2023, 12, 29),
+  // 2024
+  DaysFromCivil(2024, 1, 1), DaysFromCivil(2024, 2, 8), DaysFromCivil(2024, 2, 9),
+  DaysFromCivil(2024, 2, 14), DaysFromCivil(2024, 3, 11), DaysFromCivil(2024, 3, 12),
+  DaysFromCivil(2024, 3, 29), DaysFromCivil(2024, 4, 8), DaysFromCivil(2024, 4, 9),
+  DaysFromCivil(2024, 4, 10), DaysFromCivil(2024, 4, 11), DaysFromCivil(2024, 4, 12),
+  DaysFromCivil(2024, 4, 15), DaysFromCivil(2024, 5, 1), DaysFromCivil(2024, 5, 9),
+  DaysFromCivil(2024, 5, 10), DaysFromCivil(2024, 5, 23), DaysFromCivil(2024, 5, 24),
+  DaysFromCivil(2024, 6, 17), DaysFromCivil(2024, 6, 18), DaysFromCivil(2024, 9, 16),
+  DaysFromCivil(2024, 12, 25), DaysFromCivil(2024, 12, 26), DaysFromCivil(2024, 12, 31),
+  // 2025
+  DaysFromCivil(2025, 1, 1), DaysFromCivil(2025, 1, 27), DaysFromCivil(2025, 1, 28),
+  DaysFromCivil(2025, 1, 29), DaysFromCivil(2025, 3, 28), DaysFromCivil(2025, 3, 31),
+  DaysFromCivil(2025, 4, 1), DaysFromCivil(2025, 4, 2), DaysFromCivil(2025, 4, 3),
+  DaysFromCivil(2025, 4, 4), DaysFromCivil(2025, 4, 7), DaysFromCivil(2025, 4, 18),
+  DaysFromCivil(2025, 5, 1), DaysFromCivil(2025, 5, 12), DaysFromCivil(2025, 5, 13),
+  DaysFromCivil(2025, 5, 29), DaysFromCivil(2025, 5, 30), DaysFromCivil(2025, 6, 6),
+  DaysFromCivil(2025, 6, 9), DaysFromCivil(2025, 6, 27), DaysFromCivil(2025, 8, 18),
+  DaysFromCivil(2025, 9, 5), DaysFromCivil(2025, 12, 25), DaysFromCivil(2025, 12, 26),
+  DaysFromCivil(2025, 12, 31),
+};
+
+int32_t GapPlanner::tradingDaysInRange(int32_t from, int32_t to) {
+  if (from > to) return 0;
+  auto first = std::lower_bound(std::begin(kExchangeHolidays), std::end(kExchangeHolidays), from);
+  auto last = std::upper_bound(first, std::end(kExchangeHolidays), to);
+  return WeekdaysInRange(from, to) - static_cast<int32_t>(last - first);
+}
+
+size_t GapPlanner::plan(const Quotation* bars, size_t n, int32_t today, bool includeToday,
+                        FetchRange* out, size_t maxOut, int32_t lookbackDays) {
+  if (maxOut == 0) return 0;
+  const int32_t end = includeToday ? today : today - 1;
+
+  // Belum ada bar sama sekali: satu rentang penuh sepanjang lookback
+  if (n == 0) {
+    out[0] = FetchRange{ today - lookbackDays, end, true };
+    return 1;
+  }
+
+  size_t count = 0;
+  auto push = [&](int32_t from, int32_t to, bool trailing) {
+    if (count < maxOut) {
+      out[count++] = FetchRange{ from, to, trailing };
+    } else {
+      // Kebanyakan lubang: lebarkan rentang terakhir (satu request lebih besar, bukan banyak)
+      out[count - 1].toDay = to;
+      out[count - 1].trailing = trailing;
+    }
+  };
+
+  // ---- Lubang di tengah seri
+  int32_t prev = EodDateToDays(bars[0].DateTime.Date);
+  for (size_t i = 1; i < n; ++i) {
+    int32_t cur = EodDateToDays(bars[i].DateTime.Date);
+    if (WeekdaysInRange(prev + 1, cur - 1) > kHolidayToleranceDays &&
+        tradingDaysInRange(prev + 1, cur - 1) > 0) {
+      push(prev + 1, cur - 1, false);
+    }
+    prev = cur;
+  }
+
+  // ---- Ekor: hari bursa setelah bar terakhir sampai hari ini (atau kemarin)
+  const int32_t last = prev;
+  if (tradingDaysInRange(last + 1, end) > 0) {
+    // Mulai dari bar terakhir: bar itu mungkin disimpan saat market masih buka
+    push(last, end, true);
+  }
+  return count;
+}
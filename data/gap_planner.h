@@ -0,0 +1,37 @@
+#ifndef GAP_PLANNER_H
+#define GAP_PLANNER_H
+
+#include <cstddef>
+#include <cstdint>
+#include "plugin.h"       // Struct Quotation
+
+// ---- Rentang tanggal yang perlu di-fetch (epoch day, inklusif)
+struct FetchRange {
+  int32_t fromDay;
+  int32_t toDay;
+  bool trailing;      // true = ekor seri sampai hari ini (bukan lubang di tengah)
+};
+
+// ---- Planner delta fetch untuk seri EOD.
+// Kalender bursa = hari Senin-Jumat dikurangi libur bursa yang diketahui
+// (tabel di gap_planner.cpp, perbarui tiap kalender BEI tahunan terbit).
+// Lubang di tengah seri dilewati hanya kalau semua hari kerjanya libur bursa,
+// atau panjangnya <= kHolidayToleranceDays hari kerja (libur satu-dua hari
+// yang belum ada di tabel). Tanpa alokasi: hasil ditulis ke array 'out'.
+struct GapPlanner {
+  static constexpr int32_t kHolidayToleranceDays = 2;
+  static constexpr int32_t kDefaultLookbackDays = 365 * 2;
+  static constexpr size_t kMaxRanges = 8;
+
+  // bars[0..n) harus urut & ternormalisasi. includeToday = false kalau bar hari
+  // ini sudah disuplai live quote (WS): ekor berhenti di kemarin. Return jumlah
+  // rentang; 0 = seri sudah lengkap.
+  static size_t plan(const Quotation* bars, size_t n, int32_t today, bool includeToday,
+                     FetchRange* out, size_t maxOut = kMaxRanges,
+                     int32_t lookbackDays = kDefaultLookbackDays);
+
+  // Hari kerja di [from, to] yang bukan libur bursa (0 kalau from > to)
+  static int32_t tradingDaysInRange(int32_t from, int32_t to);
+};
+
+#endif // GAP_PLANNER_H
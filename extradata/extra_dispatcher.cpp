@@ -1,5 +1,4 @@
 #include <string>
-#include <ctime>
 #include <map>
 #include <unordered_map>
 #include "extra_dispatcher.h"
@@ -7,24 +6,8 @@
 #include "FinancialStore.h"
 #include "ritel_store.h"
 #include "ami_bridge.h"
-
-// ---- Helper untuk konversi format tanggal AmiBroker (PackDate) ke Unix Timestamp (time_t / detik)
-static DATE_TIME_INT AmiDateToUnix(DATE_TIME_INT amiDate) {
-  AmiDate dateUnion;
-  dateUnion.Date = amiDate;
-
-  std::tm tm = {};
-  tm.tm_year = dateUnion.PackDate.Year - 1900;
-  tm.tm_mon = dateUnion.PackDate.Month - 1;       // tm_mon itu 0-11
-  tm.tm_mday = dateUnion.PackDate.Day;
-  tm.tm_isdst = -1;                               // Supaya mktime otomatis deteksi DST
-
-  // mktime ngasih kita Unix timestamp (tipe time_t)
-  std::time_t unix_ts = std::mktime(&tm);
-  
-  // Cast ke unsigned __int64 (tipe DATE_TIME_INT) -> aman
-  return (DATE_TIME_INT)unix_ts;
-}
+#include "symbol_table.h"
+#include "bar_series.h"     // EodDateToUnix (00:00 waktu bursa)
 
 // ---- MAPPING AFL STRING KE FITEM_ID
 // ---- Lihat manual financial_metrics!
@@ -42,26 +25,26 @@ bool startsWith(const std::string& fullString, const std::string& prefix) {
   return fullString.rfind(prefix, 0) == 0;
 }
 
-static void fillOwnership(const std::string& symbol, const std::string& type, ExtraData* pData, float* outArr) {
-  auto data = OwnershipStore::get(symbol, type);
-
-  if (data.empty()) {
-    // 1. Buat tugas baru
-    FetchTask task;
-    task.symbol = symbol;
-    if (type == "Individual") {
-      task.type = FetchTaskType::GET_OWNERSHIP_INDIV;
-    } else if (type == "Perusahaan") {
-      task.type = FetchTaskType::GET_OWNERSHIP_CORP;
-    } else {
-      // Tipe tidak dikenal, no queue
-      for (int i = 0; i < pData->nArraySize; i++) outArr[i] = EMPTY_VAL;
-      return;
-    }
+static void fillOwnership(SymbolId symbol, const std::string& type, ExtraData* pData, float* outArr) {
+  auto data = OwnershipStore::get(symbol, SymbolTable::instance().intern(type));
+
+  // 1. Buat tugas
+  FetchTask task;
+  task.symbolId = symbol;
+  if (type == "Individual") {
+    task.type = FetchTaskType::GET_OWNERSHIP_INDIV;
+  } else if (type == "Perusahaan") {
+    task.type = FetchTaskType::GET_OWNERSHIP_CORP;
+  } else {
+    // Tipe tidak dikenal, no queue
+    for (int i = 0; i < pData->nArraySize; i++) outArr[i] = EMPTY_VAL;
+    return;
+  }
 
-    // 2. Masukkan ke antrian
-    QueueFetchTask(std::move(task));
+  // 2. Antrikan kalau status key sudah lewat TTL (kosong/gagal baru-baru ini = skip)
+  QueueExtraDataFetch(std::move(task), !data.empty());
 
+  if (data.empty()) {
     // 3. Langsung keluar (Non-blocking)
     for (int i = 0; i < pData->nArraySize; i++) {
       outArr[i] = EMPTY_VAL;
@@ -73,7 +56,7 @@ static void fillOwnership(const std::string& symbol, const std::string& type, Ex
   size_t data_idx = 0;
   float current_value = EMPTY_VAL; 
   for (int i = 0; i < pData->nArraySize; i++) {
-    DATE_TIME_INT barTs_Unix = AmiDateToUnix(pData->anTimestamps[i]);
+    DATE_TIME_INT barTs_Unix = (DATE_TIME_INT)EodDateToUnix(pData->anTimestamps[i]);
     while (data_idx < data.size() && data[data_idx].ts <= barTs_Unix) {
       if(data[data_idx].value != EMPTY_VAL) {
         current_value = data[data_idx].value;
@@ -85,17 +68,19 @@ static void fillOwnership(const std::string& symbol, const std::string& type, Ex
 }
 
 // ---- Filler untuk data Financial (Harian/Kuartalan)
-static void fillFinancial(const std::string& symbol, int fitem_id, ExtraData* pData, float* outArr) {
+static void fillFinancial(SymbolId symbol, int fitem_id, ExtraData* pData, float* outArr) {
   auto data = FinancialStore::get(symbol, fitem_id);
 
+  FetchTask task;
+  task.symbolId = symbol;
+  task.type = FetchTaskType::GET_FINANCIALS;
+
+  // Queuer tolak kalau sudah antri, atau hasil terakhir masih dalam TTL.
+  // Fetch & TTL-nya per simbol (semua item sekaligus), jadi empty/fresh
+  // ditentukan dari payload simbol, bukan dari item yang sedang diminta.
+  QueueExtraDataFetch(std::move(task), FinancialStore::hasAny(symbol));
+
   if (data.empty()) {
-    FetchTask task;
-    task.symbol = symbol;
-    task.type = FetchTaskType::GET_FINANCIALS;
-    
-    // Cuma di-queue SEKALI. Queuer akan tolak jika sudah ada
-    QueueFetchTask(std::move(task)); 
-    
     for (int i = 0; i < pData->nArraySize; i++) outArr[i] = EMPTY_VAL;
     return;
   }
@@ -105,7 +90,7 @@ static void fillFinancial(const std::string& symbol, int fitem_id, ExtraData* pD
   size_t data_idx = 0;
   float current_value = EMPTY_VAL; 
   for (int i = 0; i < pData->nArraySize; i++) {
-    DATE_TIME_INT barTs_Unix = AmiDateToUnix(pData->anTimestamps[i]);
+    DATE_TIME_INT barTs_Unix = (DATE_TIME_INT)EodDateToUnix(pData->anTimestamps[i]);
 
     while (data_idx < data.size() && data[data_idx].ts <= barTs_Unix) {
       // Jika datanya null (EMPTY_VAL) ...
@@ -120,14 +105,15 @@ static void fillFinancial(const std::string& symbol, int fitem_id, ExtraData* pD
   }
 }
 
-static void fillRitelFlow(const std::string& symbol, ExtraData* pData, float* outArr) {
+static void fillRitelFlow(SymbolId symbol, ExtraData* pData, float* outArr) {
   auto data = RitelStore::get(symbol);
-  
+
+  FetchTask task;
+  task.symbolId = symbol;
+  task.type = FetchTaskType::GET_RITEL_FLOW;
+  QueueExtraDataFetch(std::move(task), !data.empty());
+
   if (data.empty()) {
-    FetchTask task;
-    task.symbol = symbol;
-    task.type = FetchTaskType::GET_RITEL_FLOW;
-    QueueFetchTask(std::move(task));
     for (int i = 0; i < pData->nArraySize; i++) outArr[i] = EMPTY_VAL;
     return;
   }
@@ -135,7 +121,7 @@ static void fillRitelFlow(const std::string& symbol, ExtraData* pData, float* ou
   size_t data_idx = 0;
   float current_value = EMPTY_VAL; 
   for (int i = 0; i < pData->nArraySize; i++) {
-    DATE_TIME_INT barTs_Unix = AmiDateToUnix(pData->anTimestamps[i]);
+    DATE_TIME_INT barTs_Unix = (DATE_TIME_INT)EodDateToUnix(pData->anTimestamps[i]);
 
     while (data_idx < data.size() && data[data_idx].ts <= barTs_Unix) {
       // Jika datanya null (EMPTY_VAL) ...
@@ -150,17 +136,18 @@ static void fillRitelFlow(const std::string& symbol, ExtraData* pData, float* ou
   }
 }
 
-static void fillSpecificBroker(const std::string& symbol, const std::string& brokerCode, ExtraData* pData, float* outArr) {
-  // Kuncinya di Store adalah "SYMBOL_BROKER" (sesuai fetcher)
-  std::string cacheKey = symbol + "_" + brokerCode;
-  auto data = RitelStore::get(cacheKey);
-  
+static void fillSpecificBroker(SymbolId symbol, std::string_view brokerCode, ExtraData* pData, float* outArr) {
+  // Kuncinya di Store adalah (simbol, kode broker) sesuai fetcher
+  SymbolId brokerId = SymbolTable::instance().intern(brokerCode);
+  auto data = RitelStore::get(symbol, brokerId);
+
+  FetchTask task;
+  task.symbolId = symbol;
+  task.type = FetchTaskType::GET_BROKER_FLOW;
+  task.paramId = brokerId; // <-- Simpan kode broker di sini
+  QueueExtraDataFetch(std::move(task), !data.empty());   // Broker tanpa flow: kena TTL empty
+
   if (data.empty()) {
-    FetchTask task;
-    task.symbol = symbol;
-    task.type = FetchTaskType::GET_BROKER_FLOW;
-    task.extra_param = brokerCode; // <-- Simpan kode broker di sini
-    QueueFetchTask(std::move(task));
     for (int i = 0; i < pData->nArraySize; i++) outArr[i] = EMPTY_VAL;
     return ;
   }
@@ -168,7 +155,7 @@ static void fillSpecificBroker(const std::string& symbol, const std::string& bro
   size_t data_idx = 0;
   float current_value = EMPTY_VAL; 
   for (int i = 0; i < pData->nArraySize; i++) {
-    DATE_TIME_INT barTs_Unix = AmiDateToUnix(pData->anTimestamps[i]);
+    DATE_TIME_INT barTs_Unix = (DATE_TIME_INT)EodDateToUnix(pData->anTimestamps[i]);
 
     while (data_idx < data.size() && data[data_idx].ts <= barTs_Unix) {
       // Jika datanya null (EMPTY_VAL) ...
@@ -184,15 +171,21 @@ static void fillSpecificBroker(const std::string& symbol, const std::string& bro
 }
 
 void ExtraDispatcher::Handle(LPCTSTR pszTicker, LPCTSTR pszName, ExtraData* pData, float* outArr) {
-  std::string sym(pszTicker);
+  // Ticker -> ID integer sekali di sini, store & antrian pakai ID
+  SymbolId sym = SymbolTable::instance().intern(pszTicker);
   std::string field(pszName);
 
+  if (sym == kNoSymbol) {
+    for (int i = 0; i < pData->nArraySize; i++) outArr[i] = EMPTY_VAL;
+    return;
+  }
+
   // --- DYNAMIC DISPATCHER ---
   // Cek apakah request dimulai dengan "BROKERFLOW_"
   std::string prefix = "BROKERFLOW_";
   if (startsWith(field, prefix)) {
     // Ambil string setelah underscore (contoh: "XL" dari "BROKERFLOW_XL")
-    std::string brokerCode = field.substr(prefix.length());
+    std::string_view brokerCode = std::string_view(field).substr(prefix.length());
     
     if (!brokerCode.empty()) {
       return fillSpecificBroker(sym, brokerCode, pData, outArr);
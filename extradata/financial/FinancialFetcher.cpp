@@ -1,19 +1,21 @@
 #include "FinancialFetcher.h"
 #include "FinancialParser.h"
-#include "api_client.h"   // WinHttpGetData
+#include "api_client.h"   // WinHttpGetInto
+#include "parse_context.h"
 #include "config.h"       // Config::getInstance
 
 const std::string g_fitem_list = "21334,21535,1461,2896,1474,1516";
     // SHAREHOLDERS_NUM, FREE_FLOAT
 
-bool FinancialFetcher::fetch(const std::string& symbol)
+bool FinancialFetcher::fetch(SymbolId symbolId)
 {
+  const std::string& symbol = SymbolTable::instance().name(symbolId);
   std::string url = Config::getInstance().getHost() +
     "/api/amibroker/financials?item=" + g_fitem_list +
     "&companies=" + symbol + "&timeframe=5y";
 
-  std::string json = WinHttpGetData(url);
-  if (json.empty()) return false;
+  ParseContext& ctx = ParseContext::forThread();
+  if (!WinHttpGetInto(url, ctx)) return false;
 
-  return FinancialParser::parseAndStore(json, symbol);    // Kirim JSON ke parser. Parser akan simpan ke Store.
+  return FinancialParser::parseAndStore(ctx, symbolId);    // Kirim JSON ke parser. Parser akan simpan ke Store.
 }
\ No newline at end of file
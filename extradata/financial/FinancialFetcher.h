@@ -1,6 +1,7 @@
 #pragma once
 #include <string>
+#include "symbol_table.h"
 
 namespace FinancialFetcher {
-  bool fetch(const std::string& symbol);    // Cukup 1 fungsi. Dia akan fetch SEMUA metric buat 1 simbol
+  bool fetch(SymbolId symbol);    // Cukup 1 fungsi. Dia akan fetch SEMUA metric buat 1 simbol
 }
\ No newline at end of file
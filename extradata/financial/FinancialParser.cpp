@@ -16,11 +16,9 @@ static void LogFinParser(const std::string& msg) {
   OutputDebugStringA((std::string(buf) + "[FinancialParser] " + msg + "\n").c_str());
 }
 
-bool FinancialParser::parseAndStore(const std::string& json, const std::string& symbol) {
+bool FinancialParser::parseAndStore(ParseContext& ctx, SymbolId symbol) {
   try {
-    simdjson::ondemand::parser parser;
-    simdjson::padded_string ps(json);
-    auto doc = parser.iterate(ps);
+    auto doc = ctx.iterate();
     auto ratios = doc["data"].at(0)["ratios"].get_array();                    // Struktur: data -> [0] -> "ratios"
     
     int items_parsed = 0;
@@ -50,7 +48,7 @@ bool FinancialParser::parseAndStore(const std::string& json, const std::string&
         items_parsed++;
       }
     }
-    LogFinParser("Parsed " + std::to_string(items_parsed) + " financial items for " + symbol);
+    LogFinParser("Parsed " + std::to_string(items_parsed) + " financial items for " + SymbolTable::instance().name(symbol));
     return items_parsed > 0;
   } 
   catch (const simdjson::simdjson_error &e) {
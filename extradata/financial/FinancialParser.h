@@ -1,6 +1,8 @@
 #pragma once
 #include <string>
+#include "symbol_table.h"
+#include "parse_context.h"
 
 namespace FinancialParser {
-  bool parseAndStore(const std::string& json, const std::string& symbol);   // Parse JSON dan langsung simpan ke Store
+  bool parseAndStore(ParseContext& ctx, SymbolId symbol);   // Parse JSON (body di ctx) dan langsung simpan ke Store
 }
\ No newline at end of file
@@ -1,16 +1,23 @@
 #include "FinancialStore.h"
 
 std::mutex FinancialStore::mtx;
-std::map<std::string, std::map<int, std::vector<DataPoint>>> FinancialStore::store;
+IdMap<std::vector<DataPoint>> FinancialStore::store;
+IdMap<bool> FinancialStore::symbols;
 
-void FinancialStore::set(const std::string& symbol, int fitem_id, const std::vector<DataPoint>& data) {
+void FinancialStore::set(SymbolId symbol, int fitem_id, const std::vector<DataPoint>& data) {
   std::lock_guard<std::mutex> lock(mtx);
-  store[symbol][fitem_id] = data;
+  store[PackIdKey(symbol, static_cast<uint32_t>(fitem_id))] = data;
+  symbols[symbol] = true;
 }
 
-std::vector<DataPoint> FinancialStore::get(const std::string& symbol, int fitem_id) {
+std::vector<DataPoint> FinancialStore::get(SymbolId symbol, int fitem_id) {
   std::lock_guard<std::mutex> lock(mtx);
-  if (store.count(symbol) && store[symbol].count(fitem_id))
-    return store[symbol][fitem_id];
+  if (const auto* data = store.find(PackIdKey(symbol, static_cast<uint32_t>(fitem_id))))
+    return *data;
   return {};
-}
\ No newline at end of file
+}
+
+bool FinancialStore::hasAny(SymbolId symbol) {
+  std::lock_guard<std::mutex> lock(mtx);
+  return symbols.contains(symbol);
+}
@@ -1,16 +1,19 @@
 #pragma once
 #include <string>
 #include <vector>
-#include <map>
 #include <mutex>
 #include "data_point.h" // <-- Struct DataPoint
+#include "symbol_table.h"
+#include "id_map.h"
 
 class FinancialStore {
 public:
-  static void set(const std::string& symbol, int fitem_id, const std::vector<DataPoint>& data);       // Set data per item_id
-  static std::vector<DataPoint> get(const std::string& symbol, int fitem_id);                         // Get data per item_id
+  static void set(SymbolId symbol, int fitem_id, const std::vector<DataPoint>& data);       // Set data per item_id
+  static std::vector<DataPoint> get(SymbolId symbol, int fitem_id);                         // Get data per item_id
+  static bool hasAny(SymbolId symbol);                                                      // Ada item apapun (satu fetch = semua item)
 
 private:
   static std::mutex mtx;
-  static std::map<std::string, std::map<int, std::vector<DataPoint>>> store;                          // Peta data: Symbol -> item_id -> Vector Data
-};
\ No newline at end of file
+  static IdMap<std::vector<DataPoint>> store;                                               // Key: PackIdKey(symbol, item_id)
+  static IdMap<bool> symbols;                                                               // Key: symbol, yang punya minimal satu item
+};
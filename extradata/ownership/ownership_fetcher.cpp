@@ -1,19 +1,21 @@
 #include "ownership_fetcher.h"
 #include "ownership_store.h"
 #include "ownership_parser.h"
-#include "api_client.h"   // WinHttpGetData
+#include "api_client.h"   // WinHttpGetInto
+#include "parse_context.h"
 #include "config.h"
 
-bool OwnershipFetcher::fetch(const std::string& symbol, const std::string& ownerType)
+bool OwnershipFetcher::fetch(SymbolId symbolId, const std::string& ownerType)
 {
+  const std::string& symbol = SymbolTable::instance().name(symbolId);
   std::string url = Config::getInstance().getHost() +
       "/api/amibroker/ownership?symbol=" + symbol + "&value_year=60&shareholder_type=local";
 
-  std::string json = WinHttpGetData(url);
-  if (json.empty()) return false;
+  ParseContext& ctx = ParseContext::forThread();
+  if (!WinHttpGetInto(url, ctx)) return false;
 
-  auto data = OwnershipParser::parse(json, ownerType);
+  auto data = OwnershipParser::parse(ctx, ownerType);
 
-  OwnershipStore::set(symbol, ownerType, data);
+  OwnershipStore::set(symbolId, SymbolTable::instance().intern(ownerType), data);
   return true;
 }
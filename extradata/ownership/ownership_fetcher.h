@@ -1,6 +1,7 @@
 #pragma once
 #include <string>
+#include "symbol_table.h"
 
 namespace OwnershipFetcher {
-  bool fetch(const std::string& symbol, const std::string& ownerType);
+  bool fetch(SymbolId symbol, const std::string& ownerType);
 }
@@ -13,14 +13,12 @@ static void LogParser(const std::string& msg) {
   OutputDebugStringA((std::string(buf) + "[OwnershipParser] " + msg + "\n").c_str());
 }
 
-std::vector<DataPoint> OwnershipParser::parse(const std::string& json, const std::string& ownerName) {
+std::vector<DataPoint> OwnershipParser::parse(ParseContext& ctx, const std::string& ownerName) {
   std::vector<DataPoint> out;
   
   // 1. Bungkus semua pakai try-catch
   try {
-    simdjson::ondemand::parser parser;
-    simdjson::padded_string ps(json);
-    auto doc = parser.iterate(ps);
+    auto doc = ctx.iterate();
 
     auto legends = doc["data"]["legend"].get_array();
 
@@ -64,7 +62,7 @@ std::vector<DataPoint> OwnershipParser::parse(const std::string& json, const std
     }
   } 
   catch (const simdjson::simdjson_error &e) {
-    LogParser("[Extra Parser] SIMDJSON ERROR: " + std::string(e.what()) + ". JSON: " + json.substr(0, 200));
+    LogParser("[Extra Parser] SIMDJSON ERROR: " + std::string(e.what()) + ". JSON: " + ctx.body().substr(0, 200));
   } 
   catch (const std::exception &e) {
     // Catch error dari std::stoll kalau gagal
@@ -3,7 +3,8 @@
 #include <vector>
 #include "ownership_store.h"
 #include "data_point.h"
+#include "parse_context.h"
 
 namespace OwnershipParser {
-  std::vector<DataPoint> parse(const std::string& json, const std::string& ownerName);
+  std::vector<DataPoint> parse(ParseContext& ctx, const std::string& ownerName);     // JSON = ctx.body()
 }
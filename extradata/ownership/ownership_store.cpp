@@ -1,18 +1,18 @@
 #include "ownership_store.h"
 
 std::mutex OwnershipStore::mtx;
-std::map<std::string, std::map<std::string, std::vector<DataPoint>>> OwnershipStore::store;
+IdMap<std::vector<DataPoint>> OwnershipStore::store;
 
-void OwnershipStore::set(const std::string& symbol, const std::string& ownerType, const std::vector<DataPoint>& data) {
+void OwnershipStore::set(SymbolId symbol, SymbolId ownerType, const std::vector<DataPoint>& data) {
   std::lock_guard<std::mutex> lock(mtx);
-  store[symbol][ownerType] = data;
+  store[PackIdKey(symbol, ownerType)] = data;
 }
 
-std::vector<DataPoint> OwnershipStore::get(const std::string& symbol, const std::string& ownerType) {
+std::vector<DataPoint> OwnershipStore::get(SymbolId symbol, SymbolId ownerType) {
   std::lock_guard<std::mutex> lock(mtx);
 
-  if (store.count(symbol) && store[symbol].count(ownerType))
-    return store[symbol][ownerType];
+  if (const auto* data = store.find(PackIdKey(symbol, ownerType)))
+    return *data;
 
   return {};
 }
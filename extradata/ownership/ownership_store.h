@@ -1,17 +1,19 @@
 #pragma once
 #include "plugin.h"
 #include "data_point.h"
+#include "symbol_table.h"
+#include "id_map.h"
 #include <string>
 #include <vector>
-#include <map>
 #include <mutex>
 
 class OwnershipStore {
 public:
-  static void set(const std::string& symbol, const std::string& ownerType, const std::vector<DataPoint>& data);
-  static std::vector<DataPoint> get(const std::string& symbol, const std::string& ownerType);
+  // ownerType = ID hasil intern nama tipe ("Individual" / "Perusahaan")
+  static void set(SymbolId symbol, SymbolId ownerType, const std::vector<DataPoint>& data);
+  static std::vector<DataPoint> get(SymbolId symbol, SymbolId ownerType);
 
 private:
   static std::mutex mtx;
-  static std::map<std::string, std::map<std::string, std::vector<DataPoint>>> store;
+  static IdMap<std::vector<DataPoint>> store;     // Key: PackIdKey(symbol, ownerType)
 };
@@ -1,20 +1,21 @@
 #include "ritel_fetcher.h"
 #include "ritel_parser.h"
 #include "api_client.h"
+#include "parse_context.h"
 #include "config.h"
 #include <sstream>
 #include <string>
 
-bool RitelFetcher::fetch(const std::string& symbol, const std::string& brokers) {
-  std::string store_key;
+bool RitelFetcher::fetch(SymbolId symbolId, SymbolId brokerId) {
+  const std::string& symbol = SymbolTable::instance().name(symbolId);
   std::string brokers_to_process;
 
-  if (brokers.empty()) {
-    brokers_to_process = "YP,PD,XC,KK",   // default ritel flow
-    store_key = symbol;                   // Key di store: "BBRI"
+  // Key di store = (simbol, broker). Agregat default pakai broker kNoSymbol,
+  // jadi tidak overwrite data broker spesifik (misal BBRI + XL).
+  if (brokerId == kNoSymbol) {
+    brokers_to_process = "YP,PD,XC,KK";   // default ritel flow
   } else {
-    brokers_to_process = brokers;         // Specific Broker Flow
-    store_key = symbol + "_" + brokers;   // Key di store harus beda supaya tidak overwrite! Misal: "BBRI_XL"
+    brokers_to_process = SymbolTable::instance().name(brokerId);   // Specific Broker Flow
   }
 
   // Konstruksi query parameter
@@ -34,8 +35,8 @@ bool RitelFetcher::fetch(const std::string& symbol, const std::string& brokers)
       "&period=RT_PERIOD_LAST_1_YEAR" +
       broker_query_str;
 
-  std::string json = WinHttpGetData(url);
-  if (json.empty()) return false;
+  ParseContext& ctx = ParseContext::forThread();
+  if (!WinHttpGetInto(url, ctx)) return false;
 
-  return RitelParser::parseAndStore(json, store_key);
+  return RitelParser::parseAndStore(ctx, symbolId, brokerId);
 }
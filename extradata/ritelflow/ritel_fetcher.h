@@ -1,6 +1,7 @@
 #pragma once
 #include <string>
+#include "symbol_table.h"
 
 namespace RitelFetcher {
-  bool fetch(const std::string& symbol, const std::string& brokers = "");
+  bool fetch(SymbolId symbol, SymbolId broker = kNoSymbol);   // kNoSymbol = agregat ritel default
 }
\ No newline at end of file
@@ -2,13 +2,12 @@
 #include "ritel_store.h"
 #include "data_point.h"
 #include "plugin.h"
+#include "civil_date.h"
 #include <simdjson.h>
 #include <windows.h>
 #include <string>
 #include <map>
 #include <ctime>
-#include <iomanip>
-#include <sstream>
 
 static void LogRParser(const std::string& msg) {
   SYSTEMTIME t;
@@ -18,26 +17,17 @@ static void LogRParser(const std::string& msg) {
   OutputDebugStringA((std::string(buf) + "[RitelParser] " + msg + "\n").c_str());
 }
 
-// Helper konversi "YYYY-MM-DD" ke Unix timestamp
+// Helper konversi "YYYY-MM-DD" ke Unix timestamp (00:00 waktu bursa)
 static time_t StringToUnix(std::string_view date_sv) {
-  std::string date_str(date_sv);
-  int y, m, d;
-  if (sscanf_s(date_str.c_str(), "%d-%d-%d", &y, &m, &d) != 3) return 0;
-
-  std::tm tm = {};
-  tm.tm_year = y - 1900;
-  tm.tm_mon = m - 1;
-  tm.tm_mday = d;
-  tm.tm_isdst = -1;
-  return std::mktime(&tm);
+  int32_t days = 0;
+  if (!CivilDate::ParseIsoDate(date_sv, days)) return 0;
+  return static_cast<time_t>(CivilDate::UnixFromDays(days));
 }
 
 // --- Core Logic
-bool RitelParser::parseAndStore(const std::string& json, const std::string& symbol) {
+bool RitelParser::parseAndStore(ParseContext& ctx, SymbolId symbol, SymbolId broker) {
   try {
-    simdjson::ondemand::parser parser;
-    simdjson::padded_string ps(json);
-    auto doc = parser.iterate(ps);
+    auto doc = ctx.iterate();
 
     // Navigasi ke deep layer: data -> broker_chart_data[0] -> charts
     auto charts_array = doc["data"]["broker_chart_data"].at(0)["charts"].get_array();
@@ -80,8 +70,8 @@ bool RitelParser::parseAndStore(const std::string& json, const std::string& symb
     }
 
     if (!final_data.empty()) {
-      RitelStore::set(symbol, final_data);
-      LogRParser("Aggregated flow for " + symbol + ": " + std::to_string(final_data.size()) + " days.");
+      RitelStore::set(symbol, broker, final_data);
+      LogRParser("Aggregated flow for " + SymbolTable::instance().name(symbol) + ": " + std::to_string(final_data.size()) + " days.");
       return true;
     }
   }
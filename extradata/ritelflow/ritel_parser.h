@@ -1,6 +1,8 @@
 #pragma once
 #include <string>
+#include "symbol_table.h"
+#include "parse_context.h"
 
 namespace RitelParser {
-  bool parseAndStore(const std::string& json, const std::string& symbol);
+  bool parseAndStore(ParseContext& ctx, SymbolId symbol, SymbolId broker);     // JSON = ctx.body()
 }
\ No newline at end of file
@@ -1,17 +1,17 @@
 #include "ritel_store.h"
 
 std::mutex RitelStore::mtx;
-std::map<std::string, std::vector<DataPoint>> RitelStore::store;
+IdMap<std::vector<DataPoint>> RitelStore::store;
 
-void RitelStore::set(const std::string& symbol, const std::vector<DataPoint>& data) {
+void RitelStore::set(SymbolId symbol, SymbolId broker, const std::vector<DataPoint>& data) {
   std::lock_guard<std::mutex> lock(mtx);
-  store[symbol] = data;
+  store[PackIdKey(symbol, broker)] = data;
 }
 
-std::vector<DataPoint> RitelStore::get(const std::string& symbol) {
+std::vector<DataPoint> RitelStore::get(SymbolId symbol, SymbolId broker) {
   std::lock_guard<std::mutex> lock(mtx);
-  if (store.count(symbol)) {
-    return store[symbol];
+  if (const auto* data = store.find(PackIdKey(symbol, broker))) {
+    return *data;
   }
   return {};
 }
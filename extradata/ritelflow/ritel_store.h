@@ -1,16 +1,18 @@
 #pragma once
 #include <vector>
-#include <map>
 #include <string>
 #include <mutex>
 #include "data_point.h"
+#include "symbol_table.h"
+#include "id_map.h"
 
 class RitelStore {
 public:
-  static void set(const std::string& symbol, const std::vector<DataPoint>& data);
-  static std::vector<DataPoint> get(const std::string& symbol);
+  // broker = ID kode broker (BROKERFLOW_XX), atau kNoSymbol untuk agregat ritel default
+  static void set(SymbolId symbol, SymbolId broker, const std::vector<DataPoint>& data);
+  static std::vector<DataPoint> get(SymbolId symbol, SymbolId broker = kNoSymbol);
 
 private:
   static std::mutex mtx;
-  static std::map<std::string, std::vector<DataPoint>> store;
+  static IdMap<std::vector<DataPoint>> store;     // Key: PackIdKey(symbol, broker)
 };
@@ -2,13 +2,20 @@
 #include <vector>
 #include <string>
 #include <chrono>
-#include <iomanip>
-#include <sstream>
 #include <mutex>
 #include <stdexcept>
-#include <winhttp.h>
+#include <algorithm>
+#include <random>
+#include <thread>
 #include "api_client.h"
 #include "config.h"
+#include "rate_limiter.h"
+#include "circuit_breaker.h"
+#include "http_transport.h"
+#include "parse_context.h"
+#include "bar_series.h"      // ParseEodDate
+#include "civil_date.h"
+#include "historical_proto.h"
 
 // ---- simdjson (ondemand)
 #include <simdjson.h>
@@ -16,8 +23,6 @@ using namespace std::chrono;
 
 #define MAX_SYMBOL_LEN 48
 
-std::string host = Config::getInstance().getHost();
-
 // ---- Fungsi Logging & Helper ----
 void LogApi(const std::string& msg) {
   SYSTEMTIME t;
@@ -27,277 +32,384 @@ void LogApi(const std::string& msg) {
   OutputDebugStringA((std::string(buf) + msg + "\n").c_str());
 }
 
-// ---- WinHTTP Helper for GET request ----
-std::string WinHttpGetData( const std::string& url) {
-  std::string responseBody;
-  HINTERNET hSession = NULL, hConnect = NULL, hRequest = NULL;
-
-  // 1. CrackURL - memisahkan URL ke bagian komponennya seperti nama host dan path.
-  URL_COMPONENTS urlComp;
-  ZeroMemory(&urlComp, sizeof(urlComp));
-  urlComp.dwStructSize = sizeof(urlComp);
-  
-  // Alokasi buffer untuk host & path
-  const int BUF_SIZE = 1024;
-  wchar_t wsHostName[BUF_SIZE];
-  wchar_t wsUrlPath[BUF_SIZE];
-  
-  urlComp.lpszHostName = wsHostName;
-  urlComp.dwHostNameLength = BUF_SIZE;
-  urlComp.lpszUrlPath = wsUrlPath;
-  urlComp.dwUrlPathLength = BUF_SIZE;
-
-  // WinHttpCrackUrl hanya accept LPWSTR/LPCWSTR (Wide String), dan input kita adalah std::string (ANSI/UTF-8).
-  // Karena URL hanya berisi karakter ASCII standar, kita dapat menggunakan konversi sederhana.
-  // However, WinHttpCrackUrl secara native menerima LPCTSTR, jadi di Windows kita menggunakan WinHttpCrackUrlA/W
-  // Kita 'paksa' WinHttpCrackUrlW dengan conversion:
-  
-  std::wstring wsUrl(url.begin(), url.end());     // Convert string to wstring (C++11)
-
-  if (!WinHttpCrackUrl(wsUrl.c_str(), (DWORD)wsUrl.length(), 0, &urlComp)) {
-    LogApi("[WinHTTP] ERROR: WinHttpCrackUrl failed.");
-    return "";
-  }
+// ---- GET request dengan retry di atas transport keep-alive bersama ----
+// Deadline total (termasuk retry) dari config. Error transient (gagal koneksi,
+// 429, 5xx) di-retry dengan exponential backoff + jitter; Retry-After dari server
+// dihormati selama masih muat dalam deadline. Circuit breaker per endpoint
+// menolak request tanpa menyentuh jaringan selama backend dianggap down.
+// Koneksi (TCP/TLS) dipakai ulang antar request lewat DefaultHttpTransport().
+// sink != nullptr: body 2xx dialirkan ke sink, response.body kosong.
+// accept != nullptr: header Accept untuk negosiasi format body.
+static HttpResponse GetWithRetry(const std::string& url, HttpBodySink* sink, const char* accept = nullptr) {
+  HttpResponse response;      // status 0 = gagal sebelum dapat status HTTP
+
+  const Config& cfg = Config::getInstance();
+  const auto deadline = steady_clock::now() + milliseconds(std::max(1000, cfg.getHttpDeadlineMs()));
+  const int maxAttempts = 1 + std::max(0, cfg.getHttpRetries());
+  RateFamily family = ClassifyApiUrl(url);
+  thread_local std::mt19937 rng(std::random_device{}());
+
+  for (int attempt = 0; attempt < maxAttempts; attempt++) {
+    // Breaker terbuka: tolak cepat, jangan habiskan token rate limiter
+    if (CircuitBreaker::instance().shedding(family)) {
+      LogApi(std::string("[WinHTTP] Circuit open (") + RateFamilyName(family) + "), skipped " + url);
+      response = HttpResponse();
+      break;
+    }
 
-    // 2. WinHttpOpen - Open a session (use a clear User Agent)
-  hSession = WinHttpOpen(L"ValkyrieDataFeed/1.0", WINHTTP_ACCESS_TYPE_DEFAULT_PROXY, 
-                           WINHTTP_NO_PROXY_NAME, WINHTTP_NO_PROXY_BYPASS, 0);
-  if (hSession) {
-    // 3. WinHttpConnect - Connect to Host
-    hConnect = WinHttpConnect(hSession, urlComp.lpszHostName, urlComp.nPort, 0);
-  } else {
-    LogApi("[WinHTTP] ERROR: WinHttpOpen failed.");
-  }
+    // Token bucket per keluarga endpoint; latency diukur dari request dikirim
+    RateLimiter::instance().acquire(family);
+    long long remainingMs = duration_cast<milliseconds>(deadline - steady_clock::now()).count();
+    if (remainingMs <= 0) {
+      LogApi("[WinHTTP] Deadline exceeded for " + url);
+      break;
+    }
+    if (!CircuitBreaker::instance().admit(family)) {
+      LogApi(std::string("[WinHTTP] Circuit open (") + RateFamilyName(family) + "), skipped " + url);
+      response = HttpResponse();
+      break;
+    }
+    auto t_send = steady_clock::now();
 
-  if (hConnect) {
-    // 4. WinHttpOpenRequest - Open request (GET)
-    DWORD dwFlags = (urlComp.nScheme == INTERNET_SCHEME_HTTPS) ? WINHTTP_FLAG_SECURE : 0;
-      
-    hRequest = WinHttpOpenRequest(hConnect, L"GET", urlComp.lpszUrlPath, NULL, 
-                                  WINHTTP_NO_REFERER, WINHTTP_DEFAULT_ACCEPT_TYPES, dwFlags);
-  } else {
-    LogApi("[WinHTTP] ERROR: WinHttpConnect failed.");
-  }
-    
-  // Set timeout (20 detik)
-  DWORD dwTimeout = 20000; // 20000 ms
-  if (hRequest) WinHttpSetOption(hRequest, WINHTTP_OPTION_CONNECT_TIMEOUT, &dwTimeout, sizeof(dwTimeout));
-
-  if (hRequest) {
-    // 5. WinHttpSendRequest
-    if (WinHttpSendRequest(hRequest, WINHTTP_NO_ADDITIONAL_HEADERS, 0, WINHTTP_NO_REQUEST_DATA, 0, 0, 0)) {
-      // 6. WinHttpReceiveResponse
-      if (WinHttpReceiveResponse(hRequest, NULL)) {
-        DWORD dwSize = 0;
-        DWORD dwDownloaded = 0;
-        LPSTR pszOutBuffer = nullptr;
-          
-        // 7. WinHttpReadData - Loop untuk membaca seluruh response
-        do {
-          if (!WinHttpQueryDataAvailable(hRequest, &dwSize)) break;
-          if (dwSize == 0) break;
-
-          pszOutBuffer = new CHAR[dwSize + 1];
-          if (!pszOutBuffer) break;
-
-          if (!WinHttpReadData(hRequest, (LPVOID)pszOutBuffer, dwSize, &dwDownloaded)) {
-            delete[] pszOutBuffer;
-            break;
-          }
-            
-          if (dwDownloaded == 0) {
-            delete[] pszOutBuffer;
-            break;
-          }
+    DefaultHttpTransport().get(url, static_cast<int>(remainingMs), response, sink, accept);
+    const int status = response.status;
 
-          responseBody.append(pszOutBuffer, dwDownloaded);
-          delete[] pszOutBuffer;
-            
-        } while (dwSize > 0);
-      } else {
-        LogApi("[WinHTTP] ERROR: WinHttpReceiveResponse failed.");
-      }
-    } else {
-      LogApi("[WinHTTP] ERROR: WinHttpSendRequest failed.");
-    }
-  } else {
-    LogApi("[WinHTTP] ERROR: Could not open request handle.");
+    duration<double, std::milli> latency = steady_clock::now() - t_send;
+    RateLimiter::instance().report(family, status, latency.count());
+
+    // Breaker cuma menghitung tanda backend down; 429 = backend hidup tapi sibuk
+    bool transient = (status == 0 || status >= 500);
+    CircuitBreaker::instance().record(family, transient);
+    if (!transient && status != 429) break;     // Sukses / 4xx permanen
+    if (attempt + 1 >= maxAttempts) break;
+
+    // Backoff eksponensial 250ms, 500ms, 1s, ... (maks 4s) dengan jitter 50-100%
+    long long capMs = std::min<long long>(4000, 250LL << std::min(attempt, 4));
+    long long waitMs = std::uniform_int_distribution<long long>(capMs / 2, capMs)(rng);
+    waitMs = std::max<long long>(waitMs, response.retryAfterSec * 1000LL);
+    if (steady_clock::now() + milliseconds(waitMs) >= deadline) break;
+
+    LogApi("[WinHTTP] HTTP " + std::to_string(status) + " for " + url + ", retry " +
+           std::to_string(attempt + 1) + " in " + std::to_string(waitMs) + " ms");
+    std::this_thread::sleep_for(milliseconds(waitMs));
   }
 
-  // 8. Cleanup
-  if (hRequest) WinHttpCloseHandle(hRequest);
-  if (hConnect) WinHttpCloseHandle(hConnect);
-  if (hSession) WinHttpCloseHandle(hSession);
-  
-  return responseBody;
+  // Body error (429/5xx/4xx) bukan data: caller cukup lihat string kosong
+  if (response.status >= 400) {
+    LogApi("[WinHTTP] HTTP " + std::to_string(response.status) + " for " + url);
+    response.body.clear();
+  }
+  return response;
 }
 
-// ---- Helper Functions untuk Manipulasi Tanggal ----
-static std::chrono::system_clock::time_point stringToTimePoint(const std::string& date_str) {
-  std::tm tm = {};
-  std::stringstream ss(date_str);
-  ss >> std::get_time(&tm, "%Y-%m-%d");
-  // mktime uses localtime; consistent dengan kode sebelumnya
-  return std::chrono::system_clock::from_time_t(std::mktime(&tm));
+std::string WinHttpGetData(const std::string& url, int* outStatus) {
+  HttpResponse response = GetWithRetry(url, nullptr);
+  if (outStatus) *outStatus = response.status;
+  return std::move(response.body);
 }
 
-std::string timePointToString(const std::chrono::system_clock::time_point& tp) {
-  std::time_t tt = std::chrono::system_clock::to_time_t(tp);
-  std::tm tm = *std::localtime(&tt);
-  std::stringstream ss;
-  ss << std::put_time(&tm, "%Y-%m-%d");
-  return ss.str();
+bool WinHttpGetInto(const std::string& url, ParseContext& ctx, int* outStatus) {
+  HttpResponse response = GetWithRetry(url, &ctx);
+  if (outStatus) *outStatus = response.status;
+  if (response.status < 200 || response.status >= 300) {
+    ctx.begin(std::string());      // Sisa percobaan gagal bukan data
+    return false;
+  }
+  return !ctx.body().empty();
 }
 
 // ---- Utility: estimate days between two YYYY-MM-DD strings, + small margin ----
 static size_t estimate_days_between(const std::string& from, const std::string& to) {
-  try {
-    auto a = stringToTimePoint(from);
-    auto b = stringToTimePoint(to);
-    auto diff = b - a;
-    auto days = std::chrono::duration_cast<std::chrono::hours>(diff).count() / 24;
-    if (days < 0) days = 0;
-    // add small headroom for weekends/holidays or extra items
-    size_t estimate = static_cast<size_t>(days) + 8;
-    // clamp to reasonable max to avoid insane reserve
-    if (estimate > 100000) estimate = 100000;
-    return estimate;
-  } catch (...) {
+  int32_t a = 0, b = 0;
+  if (!CivilDate::ParseIsoDate(from, a) || !CivilDate::ParseIsoDate(to, b)) {
     return 1024; // fallback guess
   }
+  int32_t days = b - a;
+  if (days < 0) days = 0;
+  // add small headroom for weekends/holidays or extra items
+  size_t estimate = static_cast<size_t>(days) + 8;
+  // clamp to reasonable max to avoid insane reserve
+  if (estimate > 100000) estimate = 100000;
+  return estimate;
 }
 
-// ---- FUNGSI UTAMA: fetchHistorical ----
-// Ambil semua data dari API dalam satu panggilan penuh.
-// Parameter “from” dan “to” dikirim langsung ke endpoint backend.
-std::vector<Candle> fetchHistorical(const std::string& symbol, const std::string& from, const std::string& to) {
-  std::vector<Candle> candles;
-  std::string readBuffer;
+// ---- Satu record chartbit -> satu baris Quotation, langsung dari value simdjson.
+// Tanggal di-parse dari string_view (tanpa copy), harga langsung ke float.
+// Return false kalau tanggal tidak ada / rusak (record di-skip).
+static bool DecodeBar(simdjson::ondemand::object obj, Quotation& q) {
+  bool hasDate = false;
+  float fb = 0.0f, fs = 0.0f;
+  q = Quotation();
 
-  // Create API url (just use std::string)
-  std::string url = host + "/api/amibroker/historical?"
-    "symbol=" + symbol +
-    "&from=" + from +
-    "&to=" + to;
+  for (auto field : obj) {
+    std::string_view key = field.unescaped_key();
+    auto val = field.value();
 
-  auto t0 = high_resolution_clock::now();
-  LogApi("[API_WinHTTP] Fetching " + symbol + " from " + from + " to " + to);
+    if (key == "date") {
+      hasDate = ParseEodDate(val.get_string().value(), q.DateTime.Date);
+    }
+    else if (key == "open") {
+      q.Open = static_cast<float>(val.get_double().value());
+    }
+    else if (key == "high") {
+      q.High = static_cast<float>(val.get_double().value());
+    }
+    else if (key == "low") {
+      q.Low = static_cast<float>(val.get_double().value());
+    }
+    else if (key == "close") {
+      q.Price = static_cast<float>(val.get_double().value());
+    }
+    else if (key == "volume") {
+      q.Volume = static_cast<float>(val.get_double().value());
+    }
+    else if (key == "frequency") {
+      q.OpenInterest = static_cast<float>(val.get_double().value());
+    }
+    else if (key == "value") {
+      q.AuxData1 = static_cast<float>(val.get_double().value());
+    }
+    else if (key == "foreignbuy") {
+      fb = static_cast<float>(val.get_double().value());
+    }
+    else if (key == "foreignsell") {
+      fs = static_cast<float>(val.get_double().value());
+    }
+  }
+  q.AuxData2 = fb - fs;     // Net foreign
+  return hasDate;
+}
 
-  readBuffer = WinHttpGetData(url);
-  if (readBuffer.empty()) {
-    LogApi("[API_WinHTTP] Error: Failed to retrieve data or empty response.");
-    return candles;
+// ---- Parser "chartbit" streaming, jalan di dalam receive loop transport.
+// Potongan body masuk ke buffer ParseContext milik thread (dipakai ulang antar
+// request). Scanner kecil melacak string/escape/kedalaman kurung di dalam array
+// "chartbit"; begitu satu record {...} lengkap, record itu di-parse simdjson di
+// tempat dan dibuang dari buffer. Jadi parse berjalan selagi sisa body masih di
+// jaringan, dan buffer cuma menampung record yang belum lengkap.
+// Kalau backend menjawab protobuf (Content-Type), body cuma dikumpulkan dan
+// di-decode sekali di finish().
+class ChartbitStream : public HttpBodySink {
+public:
+  explicit ChartbitStream(std::vector<Quotation>& out)
+    : m_out(out), m_ctx(ParseContext::forThread()), m_buf(m_ctx.buffer()) {}
+
+  void begin(const std::string& contentType) override {
+    m_binary = contentType.compare(0, strlen(kHistoricalProtoType), kHistoricalProtoType) == 0;
+    m_out.clear();
+    m_buf.clear();
+    m_state = SEEK_KEY;
+    m_pos = 0;
+    m_recordStart = 0;
+    m_depth = 0;
+    m_inString = false;
+    m_escape = false;
+    m_firstByte = steady_clock::time_point();
+    m_parseTime = duration<double, std::milli>::zero();
   }
 
-  auto t_fetch = high_resolution_clock::now();
+  // Decoder menulis langsung ke ekor buffer ParseContext (padding simdjson
+  // sudah dicadangkan oleh prepare)
+  char* prepare(size_t n) override {
+    return m_ctx.prepare(n);
+  }
 
-  try {
-    size_t estimated = estimate_days_between(from, to);
-    candles.reserve(std::min<size_t>(estimated, 200000));
-
-    simdjson::ondemand::parser parser;
-    simdjson::padded_string ps(readBuffer);
-    auto doc = parser.iterate(ps);
-
-    auto data_field = doc.find_field("data");
-    simdjson::ondemand::value chartbit_val;
-    if (!data_field.error()) {
-      auto data_obj = data_field.value();
-      auto cb = data_obj.find_field("chartbit");
-      if (cb.error()) return candles;
-      chartbit_val = cb.value();
-    } else {
-      auto cb = doc.find_field("chartbit");
-      if (cb.error()) return candles;
-      chartbit_val = cb.value();
+  void commit(size_t n) override {
+    auto t = steady_clock::now();
+    if (m_firstByte == steady_clock::time_point()) m_firstByte = t;
+    m_ctx.commit(n);
+    if (m_state == DONE) {
+      m_buf.resize(m_buf.size() - n);     // Sisa dokumen setelah array tidak dibutuhkan
+      return;
+    }
+    if (!m_binary) {
+      scan();
+      compact();
     }
+    m_parseTime += steady_clock::now() - t;
+  }
 
-    auto arr = chartbit_val.get_array();
-    for (simdjson::ondemand::value item : arr) {
-      try {
-        Candle c;
-        float fb = 0.0f, fs = 0.0f;
+  // Dipanggil setelah transfer selesai. false = body rusak / terpotong.
+  bool finish() {
+    if (m_binary) {
+      auto t = steady_clock::now();
+      if (DecodeHistoricalBars(m_buf.data(), m_buf.size(), m_out)) m_state = DONE;
+      m_parseTime += steady_clock::now() - t;
+    }
+    return m_state == DONE;
+  }
 
-        auto obj = item.get_object();
-        for (auto field : obj) {
-          std::string_view key = field.unescaped_key();
-          auto val = field.value();
+  bool binary() const { return m_binary; }
+  steady_clock::time_point firstByte() const { return m_firstByte; }
+  double parseMs() const { return m_parseTime.count(); }
 
-          if (key == "date") {
-            std::string_view sv = val.get_string().value();
-            c.date.assign(sv.data(), sv.size());
-          } 
-          else if (key == "open") {
-            c.open = static_cast<float>(val.get_double().value());
-          }
-          else if (key == "high") {
-            c.high = static_cast<float>(val.get_double().value());
-          }
-          else if (key == "low") {
-            c.low = static_cast<float>(val.get_double().value());
-          }
-          else if (key == "close") {
-            c.close = static_cast<float>(val.get_double().value());
-          }
-          else if (key == "volume") {
-            c.volume = static_cast<float>(val.get_double().value());
-          }
-          else if (key == "frequency") {
-            c.frequency = static_cast<float>(val.get_double().value());
-          }
-          else if (key == "value") {
-            c.value = static_cast<float>(val.get_double().value());
-          }
-          else if (key == "foreignbuy") {
-            fb = static_cast<float>(val.get_double().value());
-          }
-          else if (key == "foreignsell") {
-            fs = static_cast<float>(val.get_double().value());
-          }
+private:
+  enum State { SEEK_KEY, SEEK_ARRAY, IN_ARRAY, DONE };
+
+  void scan() {
+    static const std::string kKey = "\"chartbit\"";
+
+    while (m_pos < m_buf.size() && m_state != DONE) {
+      if (m_state == SEEK_KEY) {
+        size_t found = m_buf.find(kKey, m_pos);
+        if (found == std::string::npos) {
+          // Key bisa terpotong di batas chunk: scan ulang ekornya nanti
+          m_pos = m_buf.size() >= kKey.size() ? m_buf.size() - kKey.size() + 1 : 0;
+          return;
         }
+        m_pos = found + kKey.size();
+        m_state = SEEK_ARRAY;
+        continue;
+      }
 
-        c.netforeign = fb - fs;
-        candles.emplace_back(std::move(c));
-      } catch (const simdjson::simdjson_error&) {
+      char ch = m_buf[m_pos];
+      if (m_state == SEEK_ARRAY) {
+        m_pos++;
+        if (ch == '[') m_state = IN_ARRAY;
+        else if (ch != ':' && !isJsonSpace(ch)) m_state = DONE;     // chartbit null / bukan array
         continue;
       }
+
+      // IN_ARRAY
+      m_pos++;
+      if (m_depth == 0) {
+        if (ch == '{') {
+          m_recordStart = m_pos - 1;
+          m_depth = 1;
+        } else if (ch == ']') {
+          m_state = DONE;
+        }
+        continue;
+      }
+      if (m_inString) {
+        if (m_escape) m_escape = false;
+        else if (ch == '\\') m_escape = true;
+        else if (ch == '"') m_inString = false;
+        continue;
+      }
+      if (ch == '"') m_inString = true;
+      else if (ch == '{' || ch == '[') m_depth++;
+      else if ((ch == '}' || ch == ']') && --m_depth == 0) parseRecord(m_recordStart, m_pos);
+    }
+  }
+
+  void parseRecord(size_t begin, size_t end) {
+    try {
+      Quotation q;
+      auto doc = m_ctx.iterate(begin, end - begin);
+      if (DecodeBar(doc.get_object(), q)) m_out.push_back(q);
+    } catch (const simdjson::simdjson_error&) {
+      // Record rusak dilewati, sama seperti parse non-streaming
+    }
+  }
+
+  // Buang byte yang sudah selesai diproses supaya buffer tidak tumbuh sebesar body
+  void compact() {
+    size_t keep = m_pos;
+    if (m_state == IN_ARRAY && m_depth > 0) keep = m_recordStart;
+    if (m_state == DONE) keep = m_buf.size();
+    if (keep == 0) return;
+
+    m_buf.erase(0, keep);
+    m_pos -= keep;
+    if (m_depth > 0) m_recordStart -= keep;
+  }
+
+  static bool isJsonSpace(char ch) {
+    return ch == ' ' || ch == '\t' || ch == '\r' || ch == '\n';
+  }
+
+  std::vector<Quotation>& m_out;
+  ParseContext& m_ctx;
+  std::string& m_buf;
+  bool m_binary = false;
+  State m_state = SEEK_KEY;
+  size_t m_pos = 0;               // Byte berikutnya yang belum di-scan
+  size_t m_recordStart = 0;       // Awal record yang sedang terbuka (m_depth > 0)
+  int m_depth = 0;
+  bool m_inString = false;
+  bool m_escape = false;
+  steady_clock::time_point m_firstByte;
+  duration<double, std::milli> m_parseTime{0};
+};
+
+// ---- FUNGSI UTAMA: fetchHistorical ----
+// Ambil semua data dari API dalam satu panggilan penuh.
+// Parameter “from” dan “to” dikirim langsung ke endpoint backend.
+// Body tidak ditampung utuh: record chartbit di-parse sambil diterima (ChartbitStream).
+// Format body dinegosiasi: minta protobuf (historical_proto.h) dengan JSON sebagai
+// alternatif; backend lama tetap menjawab JSON. Protobuf yang rusak diulang sekali
+// sebagai JSON.
+std::vector<Quotation> fetchHistorical(const std::string& symbol, const std::string& from, const std::string& to) {
+  static const char* const kAcceptBinary = "application/x-protobuf, application/json;q=0.5";
+  std::vector<Quotation> bars;
+
+  // Create API url (just use std::string)
+  std::string url = Config::getInstance().getHost() + "/api/amibroker/historical?"
+    "symbol=" + symbol +
+    "&from=" + from +
+    "&to=" + to;
+
+  LogApi("[API_WinHTTP] Fetching " + symbol + " from " + from + " to " + to);
+  bars.reserve(std::min<size_t>(estimate_days_between(from, to), 200000));
+
+  const char* accept = Config::getInstance().getHistoricalFormat() == "json" ? nullptr : kAcceptBinary;
+  ChartbitStream stream(bars);
+  HttpResponse response;
+  steady_clock::time_point t0, t_done;
+  while (true) {
+    t0 = steady_clock::now();
+    response = GetWithRetry(url, &stream, accept);
+    t_done = steady_clock::now();
+
+    if (response.status < 200 || response.status >= 300 || stream.firstByte() == steady_clock::time_point()) {
+      LogApi("[API_WinHTTP] Error: Failed to retrieve data or empty response.");
+      bars.clear();
+      return bars;
     }
+    if (stream.finish()) break;
 
-    auto t_parse = high_resolution_clock::now();
-    duration<double, std::milli> fetch_ms = t_fetch - t0;
-    duration<double, std::milli> parse_ms = t_parse - t_fetch;
-    LogApi("[API_Parser] Fetched in " + std::to_string(fetch_ms.count()) +
-        " ms, parsed " + std::to_string(candles.size()) +
-        " items in " + std::to_string(parse_ms.count()) +
-        " ms (total " + std::to_string((fetch_ms + parse_ms).count()) + " ms)");
-
-  } catch (const std::exception &e) {
-    LogApi(std::string("[API_Parser] Exception: ") + e.what());
-    return candles;
+    if (stream.binary() && accept) {
+      LogApi("[API_Parser] Error: corrupt protobuf bars for " + symbol + ", retrying as JSON");
+      accept = nullptr;
+      continue;
+    }
+    // Body terpotong / tanpa array chartbit: jangan simpan sebagian range
+    LogApi("[API_Parser] Error: chartbit array missing or truncated for " + symbol);
+    bars.clear();
+    return bars;
   }
 
-  return candles;
+  // Timing: first byte = request + server; receive = transfer body; parse berjalan
+  // di dalam receive, jadi total ~= first byte + receive (bukan + parse)
+  duration<double, std::milli> first_ms = stream.firstByte() - t0;
+  duration<double, std::milli> receive_ms = t_done - stream.firstByte();
+  duration<double, std::milli> total_ms = t_done - t0;
+  LogApi("[API_Parser] " + symbol + ": " + std::to_string(bars.size()) +
+      (stream.binary() ? " items (protobuf, " : " items (json, ") + std::to_string(response.wireBytes) +
+      " B wire), first byte " + std::to_string(first_ms.count()) +
+      " ms, receive " + std::to_string(receive_ms.count()) +
+      " ms, parse " + std::to_string(stream.parseMs()) +
+      " ms (overlapped), total " + std::to_string(total_ms.count()) + " ms");
+
+  return bars;
 }
 
 // ---- fetchSymbolList: Retrieve symbols di Configure
 std::vector<SymbolInfo> fetchSymbolList() {
   std::vector<SymbolInfo> symbol_list;
-  std::string readBuffer;
+  ParseContext& ctx = ParseContext::forThread();
 
-  std::string url = host + "/api/amibroker/emitenlist";
+  std::string url = Config::getInstance().getHost() + "/api/amibroker/emitenlist";
   LogApi("[API_Symbols] Fetching: " + url);
-  readBuffer = WinHttpGetData(url);
-  if (readBuffer.empty()) {
+  if (!WinHttpGetInto(url, ctx)) {
     LogApi("[API_Symbols] Error: Empty response");
     return symbol_list;
   }
-  LogApi("[API_Symbols] Raw response: " + readBuffer.substr(0, 200));
+  LogApi("[API_Symbols] Raw response: " + ctx.body().substr(0, 200));
 
   // Cek: valid JSON ?
   try {
-    simdjson::ondemand::parser parser;
-    simdjson::padded_string ps(readBuffer);
-    auto doc = parser.iterate(ps);
+    auto doc = ctx.iterate();
     if (doc.type() != simdjson::ondemand::json_type::object) {
       LogApi("[API_Symbols] Error: Response is not a JSON object");
       return symbol_list;
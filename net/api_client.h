@@ -5,18 +5,23 @@
 #include <vector>
 #include <chrono>
 #include "types.h" // <-- Pastikan file 'types.h' ada
+#include "plugin.h" // Struct Quotation
 #include <map>
 
 // --- Function Declarations ---
 
-// Fungsi utama untuk mengambil data historis
-std::vector<Candle> fetchHistorical(const std::string& symbol, const std::string& from, const std::string& to);
+// Fungsi utama untuk mengambil data historis. Record JSON langsung di-decode
+// ke baris Quotation (packed date + float), urut seperti dari API.
+std::vector<Quotation> fetchHistorical(const std::string& symbol, const std::string& from, const std::string& to);
 
-// Deklarasi fungsi helper (hanya "janji", tidak ada isi)
-std::string timePointToString(const std::chrono::system_clock::time_point& tp);
+// Fungsi helper untuk melakukan GET request menggunakan WinHTTP.
+// Lewat RateLimiter per endpoint; outStatus = status HTTP (0 kalau gagal koneksi).
+std::string WinHttpGetData(const std::string& url, int* outStatus = nullptr);
 
-// Fungsi helper untuk melakukan GET request menggunakan WinHTTP
-std::string WinHttpGetData(const std::string& url);
+// Sama seperti WinHttpGetData, tapi body 2xx ditulis langsung ke buffer ctx
+// (tanpa string baru). true = HTTP 2xx dengan body tidak kosong.
+class ParseContext;
+bool WinHttpGetInto(const std::string& url, ParseContext& ctx, int* outStatus = nullptr);
 
 // Fungsi untuk mengambil daftar semua simbol yang terdaftar di bursa
 std::vector<SymbolInfo> fetchSymbolList();
@@ -0,0 +1,76 @@
+#include "circuit_breaker.h"
+#include "config.h"
+#include <windows.h>
+#include <algorithm>
+#include <string>
+
+static void LogBreaker(const std::string& msg) {
+  SYSTEMTIME t;
+  GetLocalTime(&t);
+  char buf[64];
+  sprintf_s(buf, "[%02d:%02d:%02d.%03d] ", t.wHour, t.wMinute, t.wSecond, t.wMilliseconds);
+  OutputDebugStringA((std::string(buf) + "[Breaker] " + msg + "\n").c_str());
+}
+
+CircuitBreaker& CircuitBreaker::instance() {
+  static CircuitBreaker inst;
+  return inst;
+}
+
+CircuitBreaker::CircuitBreaker() {
+  const Config& cfg = Config::getInstance();
+  m_threshold = std::max(1, cfg.getBreakerThreshold());
+  m_cooldown = std::chrono::milliseconds(std::max(0, cfg.getBreakerCooldownMs()));
+}
+
+bool CircuitBreaker::admit(RateFamily family) {
+  std::lock_guard<std::mutex> lock(m_mtx);
+  Circuit& c = m_circuits[static_cast<int>(family)];
+
+  switch (c.state) {
+    case BreakerState::CLOSED:
+      return true;
+    case BreakerState::OPEN:
+      if (std::chrono::steady_clock::now() - c.openedAt < m_cooldown) return false;
+      c.state = BreakerState::HALF_OPEN;
+      LogBreaker(std::string(RateFamilyName(family)) + ": half-open, sending probe");
+      return true;
+    case BreakerState::HALF_OPEN:
+      return false;     // Probe lain masih jalan
+  }
+  return true;
+}
+
+void CircuitBreaker::record(RateFamily family, bool transientFailure) {
+  std::lock_guard<std::mutex> lock(m_mtx);
+  Circuit& c = m_circuits[static_cast<int>(family)];
+
+  if (!transientFailure) {
+    if (c.state != BreakerState::CLOSED) {
+      LogBreaker(std::string(RateFamilyName(family)) + ": closed, backend recovered");
+    }
+    c.state = BreakerState::CLOSED;
+    c.failures = 0;
+    return;
+  }
+
+  c.failures++;
+  if (c.state == BreakerState::HALF_OPEN || (c.state == BreakerState::CLOSED && c.failures >= m_threshold)) {
+    c.state = BreakerState::OPEN;
+    c.openedAt = std::chrono::steady_clock::now();
+    LogBreaker(std::string(RateFamilyName(family)) + ": OPEN after " + std::to_string(c.failures) +
+               " failures, cooldown " + std::to_string(m_cooldown.count()) + " ms");
+  }
+}
+
+bool CircuitBreaker::shedding(RateFamily family) const {
+  std::lock_guard<std::mutex> lock(m_mtx);
+  const Circuit& c = m_circuits[static_cast<int>(family)];
+  if (c.state == BreakerState::HALF_OPEN) return true;
+  return c.state == BreakerState::OPEN && std::chrono::steady_clock::now() - c.openedAt < m_cooldown;
+}
+
+BreakerState CircuitBreaker::state(RateFamily family) const {
+  std::lock_guard<std::mutex> lock(m_mtx);
+  return m_circuits[static_cast<int>(family)].state;
+}
@@ -0,0 +1,55 @@
+#ifndef CIRCUIT_BREAKER_H
+#define CIRCUIT_BREAKER_H
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <mutex>
+#include "rate_limiter.h"   // RateFamily
+
+// ---- Circuit breaker per keluarga endpoint.
+// CLOSED: request jalan normal. Setelah N kegagalan transient berturut-turut
+// (gagal koneksi / 5xx) jadi OPEN: request langsung ditolak tanpa ke jaringan
+// dan tugas antri di pool dibuang (shed). Lewat cooldown, satu request probe
+// boleh lewat (HALF_OPEN); sukses -> CLOSED, gagal -> OPEN lagi.
+enum class BreakerState : uint8_t {
+  CLOSED,
+  OPEN,
+  HALF_OPEN
+};
+
+class CircuitBreaker {
+public:
+  static CircuitBreaker& instance();
+
+  // Boleh kirim request sekarang? Di OPEN yang cooldown-nya habis, pemanggil
+  // pertama jadi probe (state -> HALF_OPEN), sisanya tetap ditolak.
+  bool admit(RateFamily family);
+
+  // Hasil request yang sudah di-admit. transientFailure = gagal koneksi / 5xx.
+  void record(RateFamily family, bool transientFailure);
+
+  // Untuk shedding di pool: true selama OPEN (belum cooldown) atau probe sedang jalan.
+  // Tidak mengubah state, aman dipanggil dari mana saja.
+  bool shedding(RateFamily family) const;
+
+  BreakerState state(RateFamily family) const;
+
+private:
+  CircuitBreaker();
+  CircuitBreaker(const CircuitBreaker&) = delete;
+  CircuitBreaker& operator=(const CircuitBreaker&) = delete;
+
+  struct Circuit {
+    BreakerState state = BreakerState::CLOSED;
+    int failures = 0;                                 // Kegagalan berturut-turut
+    std::chrono::steady_clock::time_point openedAt;
+  };
+
+  mutable std::mutex m_mtx;
+  Circuit m_circuits[static_cast<int>(RateFamily::COUNT)];
+  int m_threshold;
+  std::chrono::milliseconds m_cooldown;
+};
+
+#endif // CIRCUIT_BREAKER_H
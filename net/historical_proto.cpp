@@ -0,0 +1,116 @@
+#include "historical_proto.h"
+#include "bar_series.h"     // DaysToEodDate
+#include "pb_decode.h"
+#include <cstdint>
+
+// ---- Nomor field HistoricalBars (lihat historical_proto.h)
+enum HistoricalField : uint32_t {
+  FIELD_FIRST_DAY = 1,
+  FIELD_DAY_DELTA = 2,
+  FIELD_PRICE_DECIMALS = 3,
+  FIELD_CLOSE = 4,
+  FIELD_OPEN = 5,
+  FIELD_HIGH = 6,
+  FIELD_LOW = 7,
+  FIELD_VOLUME = 8,
+  FIELD_FREQUENCY = 9,
+  FIELD_VALUE = 10,
+  FIELD_NET_FOREIGN = 11,
+  FIELD_COUNT
+};
+
+static bool IsSignedField(uint32_t tag) {
+  return tag == FIELD_CLOSE || tag == FIELD_OPEN || tag == FIELD_HIGH || tag == FIELD_LOW || tag == FIELD_NET_FOREIGN;
+}
+
+static bool DecodeValue(pb_istream_t* stream, bool isSigned, int64_t& out) {
+  if (isSigned) return pb_decode_svarint(stream, &out);
+  uint64_t u = 0;
+  if (!pb_decode_varint(stream, &u)) return false;
+  out = static_cast<int64_t>(u);
+  return true;
+}
+
+// Field repeated: packed (satu blok length-delimited) atau satu nilai per tag.
+// Encoder wajib bisa kirim dua-duanya, jadi decoder terima dua-duanya.
+static bool DecodeRepeated(pb_istream_t* stream, pb_wire_type_t wireType, bool isSigned, std::vector<int64_t>& col) {
+  int64_t v = 0;
+  if (wireType == PB_WT_VARINT) {
+    if (!DecodeValue(stream, isSigned, v)) return false;
+    col.push_back(v);
+    return true;
+  }
+  if (wireType != PB_WT_STRING) return false;
+
+  pb_istream_t sub;
+  if (!pb_make_string_substream(stream, &sub)) return false;
+  bool ok = true;
+  while (ok && sub.bytes_left > 0) {
+    ok = DecodeValue(&sub, isSigned, v);
+    if (ok) col.push_back(v);
+  }
+  return pb_close_string_substream(stream, &sub) && ok;
+}
+
+bool DecodeHistoricalBars(const char* data, size_t len, std::vector<Quotation>& out) {
+  out.clear();
+
+  // Kolom mentah per field; dipakai ulang per thread supaya decode tidak alokasi
+  thread_local std::vector<int64_t> cols[FIELD_COUNT];
+  for (auto& col : cols) col.clear();
+  int64_t firstDay = 0;
+  uint64_t decimals = 0;
+
+  pb_istream_t stream = pb_istream_from_buffer(reinterpret_cast<const pb_byte_t*>(data), len);
+  while (true) {
+    pb_wire_type_t wireType;
+    uint32_t tag = 0;
+    bool eof = false;
+    if (!pb_decode_tag(&stream, &wireType, &tag, &eof)) {
+      if (eof) break;
+      return false;
+    }
+
+    bool ok;
+    if (tag == FIELD_FIRST_DAY && wireType == PB_WT_VARINT) {
+      ok = pb_decode_svarint(&stream, &firstDay);
+    } else if (tag == FIELD_PRICE_DECIMALS && wireType == PB_WT_VARINT) {
+      ok = pb_decode_varint(&stream, &decimals);
+    } else if (tag == FIELD_DAY_DELTA || (tag >= FIELD_CLOSE && tag < FIELD_COUNT)) {
+      ok = DecodeRepeated(&stream, wireType, IsSignedField(tag), cols[tag]);
+    } else {
+      ok = pb_skip_field(&stream, wireType);     // Field baru dari backend diabaikan
+    }
+    if (!ok) return false;
+  }
+
+  const size_t n = cols[FIELD_DAY_DELTA].size();
+  if (decimals > 9 || cols[FIELD_CLOSE].size() != n) return false;
+  for (uint32_t f = FIELD_OPEN; f < FIELD_COUNT; f++) {
+    if (!cols[f].empty() && cols[f].size() != n) return false;
+  }
+
+  static const double kPow10[10] = { 1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9 };
+  const double scale = kPow10[decimals];
+  auto at = [&](uint32_t f, size_t i) -> int64_t { return cols[f].empty() ? 0 : cols[f][i]; };
+
+  out.resize(n);
+  int64_t day = firstDay;
+  int64_t close = 0;
+  for (size_t i = 0; i < n; i++) {
+    day += cols[FIELD_DAY_DELTA][i];
+    close += cols[FIELD_CLOSE][i];
+
+    Quotation& q = out[i];
+    q.DateTime.Date = DaysToEodDate(static_cast<int32_t>(day));
+    q.Price = static_cast<float>(close / scale);
+    q.Open = static_cast<float>((close + at(FIELD_OPEN, i)) / scale);
+    q.High = static_cast<float>((close + at(FIELD_HIGH, i)) / scale);
+    q.Low = static_cast<float>((close + at(FIELD_LOW, i)) / scale);
+    q.Volume = static_cast<float>(at(FIELD_VOLUME, i));
+    q.OpenInterest = static_cast<float>(at(FIELD_FREQUENCY, i));
+    q.AuxData1 = static_cast<float>(at(FIELD_VALUE, i));
+    q.AuxData2 = static_cast<float>(at(FIELD_NET_FOREIGN, i));
+  }
+  return true;
+}
@@ -0,0 +1,34 @@
+#ifndef HISTORICAL_PROTO_H
+#define HISTORICAL_PROTO_H
+
+#include <cstddef>
+#include <vector>
+#include "plugin.h"       // Struct Quotation
+
+// ---- Format biner endpoint historical (dinegosiasi lewat header Accept).
+// Satu pesan protobuf per respons, kolom per field (packed), tanggal & harga
+// di-delta supaya varint-nya pendek:
+//
+//   message HistoricalBars {
+//     sint32 first_day = 1;               // Epoch day bar pertama (1970-01-01 = 0)
+//     repeated uint32 day_delta = 2;      // Selisih hari ke bar sebelumnya (bar pertama 0)
+//     uint32 price_decimals = 3;          // Harga = integer / 10^price_decimals (0..9)
+//     repeated sint64 close = 4;          // Delta ke close bar sebelumnya (bar pertama: nilai penuh)
+//     repeated sint64 open = 5;           // Selisih ke close bar yang sama
+//     repeated sint64 high = 6;           // Selisih ke close bar yang sama
+//     repeated sint64 low = 7;            // Selisih ke close bar yang sama
+//     repeated uint64 volume = 8;
+//     repeated uint64 frequency = 9;
+//     repeated uint64 value = 10;
+//     repeated sint64 net_foreign = 11;   // Foreign buy - foreign sell
+//   }
+//
+// Semua kolom berisi satu nilai per bar. Kolom volume..net_foreign yang
+// seluruhnya nol boleh tidak dikirim.
+static const char* const kHistoricalProtoType = "application/x-protobuf";
+
+// Decode satu pesan HistoricalBars ke baris Quotation (urut seperti di pesan).
+// Return false kalau pesan rusak / jumlah nilai antar kolom tidak cocok.
+bool DecodeHistoricalBars(const char* data, size_t len, std::vector<Quotation>& out);
+
+#endif // HISTORICAL_PROTO_H
@@ -0,0 +1,689 @@
+#include "http_transport.h"
+#include <zlib.h>
+#include <algorithm>
+#include <atomic>
+#include <cctype>
+#include <cstdio>
+#include <cstring>
+#include <map>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#ifdef _WIN32
+#include <windows.h>
+#include <winhttp.h>
+#else
+#include <netdb.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <poll.h>
+#include <sys/socket.h>
+#include <sys/time.h>
+#include <unistd.h>
+#include <cstdlib>
+#endif
+
+static void LogHttp(const std::string& msg) {
+#ifdef _WIN32
+  SYSTEMTIME t;
+  GetLocalTime(&t);
+  char buf[64];
+  sprintf_s(buf, "[%02d:%02d:%02d.%03d] ", t.wHour, t.wMinute, t.wSecond, t.wMilliseconds);
+  OutputDebugStringA((std::string(buf) + "[Http] " + msg + "\n").c_str());
+#else
+  fprintf(stderr, "[Http] %s\n", msg.c_str());
+#endif
+}
+
+// ---- Statistik transfer
+static std::atomic<uint64_t> s_responses{0};
+static std::atomic<uint64_t> s_compressedResponses{0};
+static std::atomic<uint64_t> s_wireBytes{0};
+static std::atomic<uint64_t> s_decodedBytes{0};
+static std::atomic<uint64_t> s_bufferGrowths{0};
+
+HttpTransferTotals GetHttpTransferTotals() {
+  HttpTransferTotals t;
+  t.responses = s_responses.load(std::memory_order_relaxed);
+  t.compressedResponses = s_compressedResponses.load(std::memory_order_relaxed);
+  t.wireBytes = s_wireBytes.load(std::memory_order_relaxed);
+  t.decodedBytes = s_decodedBytes.load(std::memory_order_relaxed);
+  t.bufferGrowths = s_bufferGrowths.load(std::memory_order_relaxed);
+  return t;
+}
+
+static void RecordTransfer(const HttpResponse& r, size_t decodedBytes) {
+  s_responses.fetch_add(1, std::memory_order_relaxed);
+  if (r.compressed) s_compressedResponses.fetch_add(1, std::memory_order_relaxed);
+  s_wireBytes.fetch_add(r.wireBytes, std::memory_order_relaxed);
+  s_decodedBytes.fetch_add(decodedBytes, std::memory_order_relaxed);
+}
+
+static void NoteBufferGrowth() {
+  s_bufferGrowths.fetch_add(1, std::memory_order_relaxed);
+}
+
+// Pastikan buffer transport muat n byte lagi; hitung kalau harus realokasi
+template <typename Buffer>
+static void ReserveTail(Buffer& buf, size_t n) {
+  if (buf.size() + n <= buf.capacity()) return;
+  buf.reserve(std::max(buf.size() + n, buf.capacity() * 2));
+  NoteBufferGrowth();
+}
+
+
+// ---- Tujuan byte hasil decode: buffer sink (langsung, tanpa staging) untuk
+// respons 2xx yang punya sink, selain itu HttpResponse::body. Decoder menulis
+// ke ruang dari prepare() lalu commit() jumlah byte yang terisi.
+class BodyWriter {
+public:
+  BodyWriter(HttpResponse& out, HttpBodySink* sink) : m_out(out), m_sink(sink) {
+    if (m_sink) m_sink->begin(out.contentType);
+  }
+
+  char* prepare(size_t n) {
+    if (m_sink) return m_sink->prepare(n);
+    ReserveTail(m_out.body, n);
+    m_prepared = m_out.body.size();
+    m_out.body.resize(m_prepared + n);
+    return &m_out.body[m_prepared];
+  }
+
+  void commit(size_t n) {
+    m_decoded += n;
+    if (m_sink) {
+      m_sink->commit(n);
+    } else {
+      m_out.body.resize(m_prepared + n);
+    }
+  }
+
+  // Content-Length identity: body respons dialokasi sekali
+  void reserve(size_t n) {
+    if (!m_sink) ReserveTail(m_out.body, n);
+  }
+
+  size_t decodedBytes() const { return m_decoded; }
+
+private:
+  HttpResponse& m_out;
+  HttpBodySink* m_sink;
+  size_t m_prepared = 0;
+  size_t m_decoded = 0;
+};
+
+// ---- State zlib per thread. inflateInit2 mengalokasi state + window (~40 KB),
+// jadi cukup sekali per thread; respons berikutnya cukup inflateReset2.
+struct InflateState {
+  z_stream zs;
+  bool ready = false;
+  ~InflateState() {
+    if (ready) inflateEnd(&zs);
+  }
+};
+
+static z_stream* AcquireInflate(int windowBits) {
+  thread_local InflateState t;
+  if (t.ready) return inflateReset2(&t.zs, windowBits) == Z_OK ? &t.zs : nullptr;
+  memset(&t.zs, 0, sizeof(t.zs));
+  if (inflateInit2(&t.zs, windowBits) != Z_OK) return nullptr;
+  t.ready = true;
+  NoteBufferGrowth();
+  return &t.zs;
+}
+
+// ---- Decoder body streaming: identity, gzip, atau deflate (zlib; raw deflate
+// dari server yang salah kaprah juga diterima). Data dari wire langsung di-inflate
+// ke tujuan BodyWriter, jadi tidak ada buffer compressed utuh di memori.
+class ContentDecoder {
+public:
+  explicit ContentDecoder(std::string encoding) {
+    std::transform(encoding.begin(), encoding.end(), encoding.begin(), [](unsigned char c) { return (char)std::tolower(c); });
+    m_deflate = encoding.find("deflate") != std::string::npos;
+    bool gzip = encoding.find("gzip") != std::string::npos;
+    if (!gzip && !m_deflate) return;
+
+    m_zs = AcquireInflate(15 + 32);     // 15 + 32 = header gzip/zlib dideteksi otomatis
+    m_active = m_zs != nullptr;
+    m_failed = !m_active;
+  }
+
+  bool compressed() const { return m_active || m_failed; }
+  bool failed() const { return m_failed; }
+  // Dipanggil setelah body habis: stream compressed harus sampai Z_STREAM_END,
+  // kalau tidak body-nya terpotong (walau tiap chunk ter-inflate tanpa error)
+  bool finished() const { return !compressed() || m_done; }
+
+  // Decode n byte dari wire ke 'out'. false = stream rusak.
+  bool feed(const char* data, size_t n, BodyWriter& out) {
+    m_wireBytes += n;
+    if (m_failed) return false;
+    if (!m_active) {
+      if (n == 0) return true;
+      memcpy(out.prepare(n), data, n);
+      out.commit(n);
+      return true;
+    }
+    if (m_done || n == 0) return true;    // Sisa setelah akhir stream diabaikan
+
+    m_zs->next_in = reinterpret_cast<Bytef*>(const_cast<char*>(data));
+    m_zs->avail_in = static_cast<uInt>(n);
+    while (true) {
+      size_t grow = std::max<size_t>(n * 4, 4096);      // JSON biasanya terkompres 5-10x
+      m_zs->next_out = reinterpret_cast<Bytef*>(out.prepare(grow));
+      m_zs->avail_out = static_cast<uInt>(grow);
+
+      int rc = inflate(m_zs, Z_NO_FLUSH);
+      out.commit(grow - m_zs->avail_out);
+
+      if (rc == Z_DATA_ERROR && m_deflate && !m_raw && m_zs->total_out == 0 && m_wireBytes == n) {
+        // "deflate" tanpa header zlib: ulang dari awal sebagai raw deflate
+        m_raw = true;
+        m_zs = AcquireInflate(-15);
+        if (!m_zs) {
+          m_active = false;
+          m_failed = true;
+          return false;
+        }
+        m_zs->next_in = reinterpret_cast<Bytef*>(const_cast<char*>(data));
+        m_zs->avail_in = static_cast<uInt>(n);
+        continue;
+      }
+      if (rc == Z_STREAM_END) {
+        m_done = true;
+        return true;
+      }
+      if (rc == Z_BUF_ERROR) return true;     // Butuh input berikutnya
+      if (rc != Z_OK) {
+        m_failed = true;
+        return false;
+      }
+      if (m_zs->avail_in == 0 && m_zs->avail_out > 0) return true;
+    }
+  }
+
+  size_t wireBytes() const { return m_wireBytes; }
+
+private:
+  z_stream* m_zs = nullptr;       // Milik thread (AcquireInflate), bukan decoder
+  bool m_active = false;
+  bool m_failed = false;
+  bool m_deflate = false;
+  bool m_raw = false;
+  bool m_done = false;
+  size_t m_wireBytes = 0;
+};
+
+#ifdef _WIN32
+
+// ---- WinHTTP: satu session untuk seluruh plugin. WinHTTP menyimpan koneksi
+// keep-alive (TCP + TLS) di session, jadi request berikutnya ke host yang sama
+// tidak DNS/connect/handshake ulang. Handle connect di-cache per host:port;
+// yang dibuka-tutup per request cuma handle request.
+class WinHttpTransport : public HttpTransport {
+public:
+  WinHttpTransport() {
+    m_session = WinHttpOpen(L"ValkyrieDataFeed/1.0", WINHTTP_ACCESS_TYPE_DEFAULT_PROXY,
+                            WINHTTP_NO_PROXY_NAME, WINHTTP_NO_PROXY_BYPASS, 0);
+    if (!m_session) {
+      LogHttp("ERROR: WinHttpOpen failed.");
+      return;
+    }
+    // Cukup untuk semua worker pool + WS key / daftar simbol sekaligus
+    DWORD maxConns = 16;
+    WinHttpSetOption(m_session, WINHTTP_OPTION_MAX_CONNS_PER_SERVER, &maxConns, sizeof(maxConns));
+  }
+
+  bool get(const std::string& url, int timeoutMs, HttpResponse& out, HttpBodySink* sink, const char* accept) override {
+    out = HttpResponse();
+    if (!m_session) return false;
+
+    // 1. CrackURL - memisahkan URL ke bagian komponennya seperti nama host dan path.
+    URL_COMPONENTS urlComp;
+    ZeroMemory(&urlComp, sizeof(urlComp));
+    urlComp.dwStructSize = sizeof(urlComp);
+
+    const int BUF_SIZE = 1024;
+    wchar_t wsHostName[BUF_SIZE];
+    wchar_t wsUrlPath[BUF_SIZE];
+    urlComp.lpszHostName = wsHostName;
+    urlComp.dwHostNameLength = BUF_SIZE;
+    urlComp.lpszUrlPath = wsUrlPath;
+    urlComp.dwUrlPathLength = BUF_SIZE;
+
+    std::wstring wsUrl(url.begin(), url.end());     // URL cuma ASCII
+    if (!WinHttpCrackUrl(wsUrl.c_str(), (DWORD)wsUrl.length(), 0, &urlComp)) {
+      LogHttp("ERROR: WinHttpCrackUrl failed.");
+      return false;
+    }
+
+    // 2. Handle connect dari cache (tidak ada I/O jaringan di sini)
+    HINTERNET hConnect = connectionFor(urlComp.lpszHostName, urlComp.nPort);
+    if (!hConnect) return false;
+
+    // 3. WinHttpOpenRequest - Open request (GET)
+    DWORD dwFlags = (urlComp.nScheme == INTERNET_SCHEME_HTTPS) ? WINHTTP_FLAG_SECURE : 0;
+    HINTERNET hRequest = WinHttpOpenRequest(hConnect, L"GET", urlComp.lpszUrlPath, NULL,
+                                            WINHTTP_NO_REFERER, WINHTTP_DEFAULT_ACCEPT_TYPES, dwFlags);
+    if (!hRequest) {
+      LogHttp("ERROR: Could not open request handle.");
+      return false;
+    }
+
+    // Timeout: connect maks 20 detik, semuanya dibatasi sisa deadline
+    int connectMs = timeoutMs < 20000 ? timeoutMs : 20000;
+    WinHttpSetTimeouts(hRequest, connectMs, connectMs, timeoutMs, timeoutMs);
+
+    // Decompress sendiri (bukan WINHTTP_OPTION_DECOMPRESSION) supaya byte wire terhitung
+    std::wstring headers = L"Accept-Encoding: gzip, deflate";
+    if (accept) headers += L"\r\nAccept: " + std::wstring(accept, accept + strlen(accept));
+    bool ok = false;
+    if (!WinHttpSendRequest(hRequest, headers.c_str(), (DWORD)-1, WINHTTP_NO_REQUEST_DATA, 0, 0, 0)) {
+      LogHttp("ERROR: WinHttpSendRequest failed.");
+    } else if (!WinHttpReceiveResponse(hRequest, NULL)) {
+      LogHttp("ERROR: WinHttpReceiveResponse failed.");
+    } else {
+      DWORD dwStatusCode = 0;
+      DWORD dwSize = sizeof(dwStatusCode);
+      WinHttpQueryHeaders(hRequest, WINHTTP_QUERY_STATUS_CODE | WINHTTP_QUERY_FLAG_NUMBER,
+                          WINHTTP_HEADER_NAME_BY_INDEX, &dwStatusCode, &dwSize, WINHTTP_NO_HEADER_INDEX);
+      out.status = static_cast<int>(dwStatusCode);
+
+      if (dwStatusCode == 429 || dwStatusCode == 503) {
+        DWORD retryAfter = 0;
+        dwSize = sizeof(retryAfter);
+        if (WinHttpQueryHeaders(hRequest, WINHTTP_QUERY_RETRY_AFTER | WINHTTP_QUERY_FLAG_NUMBER,
+                                WINHTTP_HEADER_NAME_BY_INDEX, &retryAfter, &dwSize, WINHTTP_NO_HEADER_INDEX)) {
+          out.retryAfterSec = retryAfter;
+        }
+      }
+
+      std::string encoding = queryHeader(hRequest, WINHTTP_QUERY_CONTENT_ENCODING);
+      out.contentType = queryHeader(hRequest, WINHTTP_QUERY_CONTENT_TYPE);
+      ContentDecoder decoder(encoding);
+      BodyWriter writer(out, dwStatusCode >= 200 && dwStatusCode < 300 ? sink : nullptr);
+
+      // 4. Baca body per chunk wire dan decode langsung ke tujuan. Body harus
+      // habis dibaca supaya koneksinya bisa kembali ke pool keep-alive WinHTTP.
+      // Gagal baca di tengah body = body terpotong: gagal transport (sama
+      // dengan recv() gagal di backend POSIX), jangan dianggap sukses.
+      // Buffer wire per thread: dipakai ulang antar request, cuma tumbuh
+      thread_local std::vector<char> raw;
+      ok = true;
+      bool readFailed = false;
+      DWORD dwAvailable = 0;
+      while (ok) {
+        if (!WinHttpQueryDataAvailable(hRequest, &dwAvailable)) {
+          readFailed = true;
+          break;
+        }
+        if (dwAvailable == 0) break;      // Body habis
+        if (raw.size() < dwAvailable) {
+          if (raw.capacity() < dwAvailable) NoteBufferGrowth();
+          raw.resize(dwAvailable);
+        }
+        DWORD dwDownloaded = 0;
+        if (!WinHttpReadData(hRequest, raw.data(), dwAvailable, &dwDownloaded)) {
+          readFailed = true;
+          break;
+        }
+        if (dwDownloaded == 0) break;
+        ok = decoder.feed(raw.data(), dwDownloaded, writer);
+      }
+
+      out.wireBytes = decoder.wireBytes();
+      out.compressed = decoder.compressed();
+      if (readFailed) {
+        LogHttp("ERROR: body read failed (" + std::to_string(GetLastError()) + "), response truncated.");
+        ok = false;
+      } else if (!ok) {
+        LogHttp("ERROR: corrupt " + encoding + " body.");
+      } else if (!decoder.finished()) {
+        LogHttp("ERROR: truncated " + encoding + " body (stream ended early).");
+        ok = false;
+      }
+      if (!ok) {
+        out.status = 0;
+        out.body.clear();
+      }
+      RecordTransfer(out, writer.decodedBytes());
+    }
+
+    WinHttpCloseHandle(hRequest);
+    return ok;
+  }
+
+private:
+  // Header string pendek (ASCII), huruf kecil. Kosong kalau tidak ada.
+  static std::string queryHeader(HINTERNET hRequest, DWORD query) {
+    wchar_t wsValue[128];
+    DWORD dwSize = sizeof(wsValue);
+    std::string value;
+    if (WinHttpQueryHeaders(hRequest, query, WINHTTP_HEADER_NAME_BY_INDEX, wsValue, &dwSize, WINHTTP_NO_HEADER_INDEX)) {
+      for (DWORD i = 0; i < dwSize / sizeof(wchar_t); i++) value += (char)std::tolower((char)wsValue[i]);
+    }
+    return value;
+  }
+
+  HINTERNET connectionFor(const wchar_t* host, INTERNET_PORT port) {
+    std::wstring key = std::wstring(host) + L":" + std::to_wstring(port);
+    std::lock_guard<std::mutex> lock(m_mtx);
+
+    auto it = m_connections.find(key);
+    if (it != m_connections.end()) return it->second;
+
+    HINTERNET hConnect = WinHttpConnect(m_session, host, port, 0);
+    if (!hConnect) {
+      LogHttp("ERROR: WinHttpConnect failed.");
+      return NULL;
+    }
+    m_connections.emplace(key, hConnect);
+    return hConnect;
+  }
+
+  HINTERNET m_session = NULL;
+  std::mutex m_mtx;
+  std::map<std::wstring, HINTERNET> m_connections;    // "host:port" -> handle connect
+};
+
+HttpTransport& DefaultHttpTransport() {
+  // Sengaja tidak di-destroy: menutup handle WinHTTP saat DLL unload (loader lock) rawan deadlock
+  static WinHttpTransport* inst = new WinHttpTransport();
+  return *inst;
+}
+
+#else
+
+// ---- POSIX: HTTP/1.1 plain (tanpa TLS) di atas socket blocking. Socket yang
+// selesai dengan keep-alive disimpan per host:port dan dipakai request
+// berikutnya. Dipakai untuk build non-Windows (benchmark / stand-in server lokal).
+class PosixHttpTransport : public HttpTransport {
+public:
+  ~PosixHttpTransport() override {
+    for (auto& entry : m_idle) {
+      for (int fd : entry.second) ::close(fd);
+    }
+  }
+
+  bool get(const std::string& url, int timeoutMs, HttpResponse& out, HttpBodySink* sink, const char* accept) override {
+    out = HttpResponse();
+    Url u;
+    if (!parseUrl(url, u)) {
+      LogHttp("ERROR: unsupported URL (POSIX backend is plain http only): " + url);
+      return false;
+    }
+    const std::string key = u.host + ":" + u.port;
+
+    // Socket idle bisa sudah ditutup server walau lolos cek di takeIdle: ulang
+    // sekali pakai koneksi baru, tapi hanya kalau request belum terkirim. Gagal
+    // setelah request terkirim diserahkan ke retry/breaker di atas transport.
+    int fd = takeIdle(key);
+    bool reused = fd >= 0;
+    for (int attempt = 0; attempt < 2; attempt++) {
+      if (fd < 0) fd = connectTo(u, timeoutMs);
+      if (fd < 0) return false;
+
+      bool keepAlive = false;
+      bool sent = false;
+      if (roundTrip(fd, u, timeoutMs, sink, accept, out, keepAlive, sent)) {
+        if (keepAlive) {
+          putIdle(key, fd);
+        } else {
+          ::close(fd);
+        }
+        return true;
+      }
+      ::close(fd);
+      fd = -1;
+      out = HttpResponse();
+      if (!reused || sent) break;
+      reused = false;
+    }
+    return false;
+  }
+
+private:
+  struct Url {
+    std::string host;
+    std::string port;
+    std::string path;
+  };
+
+  static bool parseUrl(const std::string& url, Url& out) {
+    const std::string scheme = "http://";
+    if (url.compare(0, scheme.size(), scheme) != 0) return false;
+
+    size_t hostBegin = scheme.size();
+    size_t pathBegin = url.find('/', hostBegin);
+    std::string authority = url.substr(hostBegin, pathBegin == std::string::npos ? std::string::npos : pathBegin - hostBegin);
+    out.path = pathBegin == std::string::npos ? "/" : url.substr(pathBegin);
+
+    size_t colon = authority.rfind(':');
+    out.host = colon == std::string::npos ? authority : authority.substr(0, colon);
+    out.port = colon == std::string::npos ? "80" : authority.substr(colon + 1);
+    return !out.host.empty();
+  }
+
+  // Socket idle yang sudah ditutup server (keep-alive timeout) terbaca EOF tanpa
+  // menunggu; socket idle yang readable (EOF, RST, byte liar) dibuang sebelum dipakai
+  int takeIdle(const std::string& key) {
+    std::lock_guard<std::mutex> lock(m_mtx);
+    auto it = m_idle.find(key);
+    if (it == m_idle.end()) return -1;
+    while (!it->second.empty()) {
+      int fd = it->second.back();
+      it->second.pop_back();
+      pollfd pfd{ fd, POLLIN, 0 };
+      if (::poll(&pfd, 1, 0) == 0) return fd;
+      ::close(fd);
+    }
+    return -1;
+  }
+
+  void putIdle(const std::string& key, int fd) {
+    std::lock_guard<std::mutex> lock(m_mtx);
+    m_idle[key].push_back(fd);
+  }
+
+  static void setTimeouts(int fd, int timeoutMs) {
+    timeval tv;
+    tv.tv_sec = timeoutMs / 1000;
+    tv.tv_usec = (timeoutMs % 1000) * 1000;
+    setsockopt(fd, SOL_SOCKET, SO_RCVTIMEO, &tv, sizeof(tv));
+    setsockopt(fd, SOL_SOCKET, SO_SNDTIMEO, &tv, sizeof(tv));
+  }
+
+  static int connectTo(const Url& u, int timeoutMs) {
+    addrinfo hints;
+    memset(&hints, 0, sizeof(hints));
+    hints.ai_family = AF_UNSPEC;
+    hints.ai_socktype = SOCK_STREAM;
+
+    addrinfo* result = nullptr;
+    if (getaddrinfo(u.host.c_str(), u.port.c_str(), &hints, &result) != 0) {
+      LogHttp("ERROR: getaddrinfo failed for " + u.host);
+      return -1;
+    }
+
+    int fd = -1;
+    for (addrinfo* ai = result; ai; ai = ai->ai_next) {
+      fd = ::socket(ai->ai_family, ai->ai_socktype, ai->ai_protocol);
+      if (fd < 0) continue;
+      setTimeouts(fd, timeoutMs);     // SO_SNDTIMEO juga membatasi connect()
+      if (::connect(fd, ai->ai_addr, ai->ai_addrlen) == 0) break;
+      ::close(fd);
+      fd = -1;
+    }
+    freeaddrinfo(result);
+
+    if (fd < 0) {
+      LogHttp("ERROR: connect failed to " + u.host + ":" + u.port);
+      return -1;
+    }
+    int one = 1;
+    setsockopt(fd, IPPROTO_TCP, TCP_NODELAY, &one, sizeof(one));
+    return fd;
+  }
+
+  static bool sendAll(int fd, const std::string& data) {
+    size_t sent = 0;
+    while (sent < data.size()) {
+      ssize_t n = ::send(fd, data.data() + sent, data.size() - sent, MSG_NOSIGNAL);
+      if (n <= 0) return false;
+      sent += static_cast<size_t>(n);
+    }
+    return true;
+  }
+
+  // Tambah data dari socket ke buf. false = EOF / error / timeout.
+  static bool recvMore(int fd, std::string& buf) {
+    char chunk[16384];
+    ssize_t n = ::recv(fd, chunk, sizeof(chunk), 0);
+    if (n <= 0) return false;
+    ReserveTail(buf, static_cast<size_t>(n));
+    buf.append(chunk, static_cast<size_t>(n));
+    return true;
+  }
+
+  static bool roundTrip(int fd, const Url& u, int timeoutMs, HttpBodySink* sink, const char* accept,
+                        HttpResponse& out, bool& keepAlive, bool& sent) {
+    setTimeouts(fd, timeoutMs);
+
+    // Buffer request & wire per thread: dipakai ulang antar request, cuma tumbuh
+    thread_local std::string request;
+    thread_local std::string buf;
+    const size_t requestCapacity = request.capacity();
+    request.clear();
+    request.append("GET ").append(u.path).append(" HTTP/1.1\r\nHost: ").append(u.host).append("\r\n"
+                   "User-Agent: ValkyrieDataFeed/1.0\r\n"
+                   "Accept-Encoding: gzip, deflate\r\n");
+    if (accept) request.append("Accept: ").append(accept).append("\r\n");
+    request.append("Connection: keep-alive\r\n\r\n");
+    if (request.capacity() != requestCapacity) NoteBufferGrowth();
+    if (!sendAll(fd, request)) return false;
+    sent = true;
+
+    // ---- Header
+    buf.clear();
+    size_t headerEnd;
+    while ((headerEnd = buf.find("\r\n\r\n")) == std::string::npos) {
+      if (!recvMore(fd, buf)) return false;
+    }
+
+    int status = 0;
+    if (sscanf(buf.c_str(), "HTTP/%*d.%*d %d", &status) != 1) return false;
+
+    long long contentLength = -1;
+    bool chunked = false;
+    std::string encoding;
+    keepAlive = buf.compare(0, 8, "HTTP/1.0") != 0;
+    size_t lineBegin = buf.find("\r\n") + 2;
+    while (lineBegin < headerEnd) {
+      size_t lineEnd = buf.find("\r\n", lineBegin);
+      std::string line = buf.substr(lineBegin, lineEnd - lineBegin);
+      lineBegin = lineEnd + 2;
+
+      size_t colon = line.find(':');
+      if (colon == std::string::npos) continue;
+      std::string name = line.substr(0, colon);
+      std::string value = line.substr(colon + 1);
+      value.erase(0, value.find_first_not_of(" \t"));
+      std::transform(name.begin(), name.end(), name.begin(), [](unsigned char c) { return (char)std::tolower(c); });
+      std::transform(value.begin(), value.end(), value.begin(), [](unsigned char c) { return (char)std::tolower(c); });
+
+      if (name == "content-length") contentLength = std::atoll(value.c_str());
+      else if (name == "transfer-encoding") chunked = value.find("chunked") != std::string::npos;
+      else if (name == "connection") keepAlive = value.find("close") == std::string::npos;
+      else if (name == "retry-after") out.retryAfterSec = static_cast<unsigned>(std::atoi(value.c_str()));
+      else if (name == "content-encoding") encoding = value;
+      else if (name == "content-type") out.contentType = value;
+    }
+    buf.erase(0, headerEnd + 4);
+
+    // ---- Body (di-decode per potongan yang diterima, buf cuma menampung sisa wire)
+    ContentDecoder decoder(encoding);
+    BodyWriter writer(out, status >= 200 && status < 300 ? sink : nullptr);
+    if (!readBody(fd, buf, chunked, contentLength, decoder, writer, keepAlive)) {
+      if (decoder.failed()) LogHttp("ERROR: corrupt " + encoding + " body.");
+      return false;
+    }
+    if (!decoder.finished()) {
+      LogHttp("ERROR: truncated " + encoding + " body (stream ended early).");
+      return false;
+    }
+    if (!buf.empty()) keepAlive = false;    // Byte setelah akhir body: posisi stream tidak bisa dipercaya
+    out.wireBytes = decoder.wireBytes();
+    out.compressed = decoder.compressed();
+    out.status = status;
+    RecordTransfer(out, writer.decodedBytes());
+    return true;
+  }
+
+  static bool readBody(int fd, std::string& buf, bool chunked, long long contentLength,
+                       ContentDecoder& decoder, BodyWriter& writer, bool& keepAlive) {
+    if (chunked) {
+      // Tiap chunk: "<hex>\r\n<data>\r\n", diakhiri chunk 0, lalu trailer
+      // (nol atau lebih baris header) dan baris kosong
+      while (true) {
+        size_t sizeEnd;
+        while ((sizeEnd = buf.find("\r\n")) == std::string::npos) {
+          if (!recvMore(fd, buf)) return false;
+        }
+        size_t chunkSize = std::strtoul(buf.c_str(), nullptr, 16);
+        buf.erase(0, sizeEnd + 2);
+        if (chunkSize == 0) {
+          // Trailer dibuang seluruhnya supaya socket keep-alive bersih untuk request berikutnya
+          while (true) {
+            size_t lineEnd;
+            while ((lineEnd = buf.find("\r\n")) == std::string::npos) {
+              if (!recvMore(fd, buf)) return false;
+            }
+            buf.erase(0, lineEnd + 2);
+            if (lineEnd == 0) return true;
+          }
+        }
+        // Isi chunk diteruskan ke decoder sedikit demi sedikit
+        while (chunkSize > 0) {
+          if (buf.empty() && !recvMore(fd, buf)) return false;
+          size_t n = std::min(chunkSize, buf.size());
+          if (!decoder.feed(buf.data(), n, writer)) return false;
+          buf.erase(0, n);
+          chunkSize -= n;
+        }
+        while (buf.size() < 2) {
+          if (!recvMore(fd, buf)) return false;
+        }
+        buf.erase(0, 2);
+      }
+    } else if (contentLength >= 0) {
+      if (!decoder.compressed()) writer.reserve(static_cast<size_t>(contentLength));
+      size_t remaining = static_cast<size_t>(contentLength);
+      while (remaining > 0) {
+        if (buf.empty() && !recvMore(fd, buf)) return false;
+        size_t n = std::min(remaining, buf.size());
+        if (!decoder.feed(buf.data(), n, writer)) return false;
+        buf.erase(0, n);
+        remaining -= n;
+      }
+    } else {
+      // Tanpa panjang: body sampai server menutup koneksi
+      do {
+        if (!decoder.feed(buf.data(), buf.size(), writer)) return false;
+        buf.clear();
+      } while (recvMore(fd, buf));
+      keepAlive = false;
+    }
+    return true;
+  }
+
+  std::mutex m_mtx;
+  std::map<std::string, std::vector<int>> m_idle;   // "host:port" -> socket keep-alive idle
+};
+
+HttpTransport& DefaultHttpTransport() {
+  static PosixHttpTransport inst;
+  return inst;
+}
+
+#endif
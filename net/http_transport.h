@@ -0,0 +1,67 @@
+#ifndef HTTP_TRANSPORT_H
+#define HTTP_TRANSPORT_H
+
+#include <cstdint>
+#include <string>
+
+// ---- Hasil satu request GET
+struct HttpResponse {
+  int status = 0;                 // 0 = gagal sebelum dapat status HTTP (DNS/connect/timeout)
+  unsigned retryAfterSec = 0;     // Header Retry-After (detik), 0 kalau tidak ada
+  size_t wireBytes = 0;           // Byte body di wire (sebelum decompress)
+  bool compressed = false;        // Content-Encoding gzip/deflate
+  std::string contentType;        // Header Content-Type (huruf kecil), untuk negosiasi format
+  std::string body;               // Sudah di-decode
+};
+
+// ---- Total transfer sejak plugin load (semua backend, semua endpoint)
+struct HttpTransferTotals {
+  uint64_t responses = 0;
+  uint64_t compressedResponses = 0;
+  uint64_t wireBytes = 0;         // Body seperti dikirim server
+  uint64_t decodedBytes = 0;      // Body setelah decompress
+  uint64_t bufferGrowths = 0;     // Buffer wire / state zlib / body respons yang harus dialokasi (ulang)
+};
+HttpTransferTotals GetHttpTransferTotals();
+
+// ---- Penerima body streaming (opsional). Dipakai hanya untuk respons 2xx:
+// decoder menulis byte hasil decode langsung ke buffer milik sink (tanpa staging
+// di HttpResponse::body). Body error (4xx/5xx) tetap masuk ke body seperti biasa.
+class HttpBodySink {
+public:
+  virtual ~HttpBodySink() = default;
+
+  // Percobaan baru: buang data percobaan sebelumnya. contentType = header
+  // Content-Type respons (huruf kecil), supaya sink bisa pilih decoder.
+  virtual void begin(const std::string& contentType) = 0;
+
+  // Ruang tulis n byte tepat di belakang data yang sudah diterima. Transport
+  // mengisi sebagian lalu commit(jumlah byte terisi); pointer tidak dipakai
+  // lagi setelah commit.
+  virtual char* prepare(size_t n) = 0;
+  virtual void commit(size_t n) = 0;
+};
+
+// ---- Transport HTTP dengan koneksi keep-alive yang dipakai ulang.
+// Satu instance dipakai bersama oleh semua fetcher & worker; implementasi
+// harus thread-safe. Request selalu kirim "Accept-Encoding: gzip, deflate";
+// body di-decompress sambil dibaca (zlib streaming), bukan setelah terkumpul.
+// Retry, deadline, rate limit dan circuit breaker ada di atasnya
+// (WinHttpGetData), transport cuma satu percobaan.
+class HttpTransport {
+public:
+  virtual ~HttpTransport() = default;
+
+  // timeoutMs membatasi resolve/connect/send/receive percobaan ini.
+  // Return false kalau gagal di level transport (out.status = 0).
+  // sink != nullptr: body 2xx dialirkan ke sink (sink->begin() dipanggil dulu).
+  // accept != nullptr: dikirim sebagai header Accept (negosiasi format body).
+  virtual bool get(const std::string& url, int timeoutMs, HttpResponse& out, HttpBodySink* sink = nullptr,
+                   const char* accept = nullptr) = 0;
+};
+
+// Backend default: WinHTTP (satu session, handle connect per host) di Windows,
+// socket POSIX (HTTP/1.1 plain, pool socket idle per host) di luar Windows.
+HttpTransport& DefaultHttpTransport();
+
+#endif // HTTP_TRANSPORT_H
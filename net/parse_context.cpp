@@ -0,0 +1,68 @@
+#include "parse_context.h"
+#include <algorithm>
+
+static std::atomic<uint64_t> s_contexts{0};
+static std::atomic<uint64_t> s_parses{0};
+static std::atomic<uint64_t> s_bufferGrowths{0};
+static std::atomic<uint64_t> s_parserGrowths{0};
+
+ParseAllocStats GetParseAllocStats() {
+  ParseAllocStats s;
+  s.contexts = s_contexts.load(std::memory_order_relaxed);
+  s.parses = s_parses.load(std::memory_order_relaxed);
+  s.bufferGrowths = s_bufferGrowths.load(std::memory_order_relaxed);
+  s.parserGrowths = s_parserGrowths.load(std::memory_order_relaxed);
+  s.transportGrowths = GetHttpTransferTotals().bufferGrowths;
+  return s;
+}
+
+ParseContext& ParseContext::forThread() {
+  thread_local ParseContext ctx;
+  return ctx;
+}
+
+ParseContext::ParseContext() {
+  s_contexts.fetch_add(1, std::memory_order_relaxed);
+}
+
+void ParseContext::begin(const std::string&) {
+  m_body.clear();     // Kapasitas tetap
+}
+
+char* ParseContext::prepare(size_t n) {
+  reserve(n);     // resize di bawah tidak realokasi
+  m_prepared = m_body.size();
+  m_body.resize(m_prepared + n);
+  return &m_body[m_prepared];
+}
+
+void ParseContext::commit(size_t n) {
+  m_body.resize(m_prepared + n);
+}
+
+void ParseContext::reserve(size_t n) {
+  size_t needed = m_body.size() + n + simdjson::SIMDJSON_PADDING;
+  if (needed <= m_body.capacity()) return;
+
+  // Tumbuh geometris supaya body yang membesar pelan-pelan tidak realokasi tiap chunk
+  m_body.reserve(std::max(needed, m_body.capacity() * 2));
+  s_bufferGrowths.fetch_add(1, std::memory_order_relaxed);
+}
+
+simdjson::simdjson_result<simdjson::ondemand::document> ParseContext::iterate() {
+  return iterate(0, m_body.size());
+}
+
+simdjson::simdjson_result<simdjson::ondemand::document> ParseContext::iterate(size_t begin, size_t len) {
+  reserve(0);     // Body dari luar write() (misal assign) belum tentu punya padding
+  s_parses.fetch_add(1, std::memory_order_relaxed);
+  auto doc = m_parser.iterate(m_body.data() + begin, len, m_body.capacity() - begin);
+  noteParserCapacity();
+  return doc;
+}
+
+void ParseContext::noteParserCapacity() {
+  if (m_parser.capacity() == m_parserCapacity) return;
+  m_parserCapacity = m_parser.capacity();
+  s_parserGrowths.fetch_add(1, std::memory_order_relaxed);
+}
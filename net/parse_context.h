@@ -0,0 +1,60 @@
+#ifndef PARSE_CONTEXT_H
+#define PARSE_CONTEXT_H
+
+#include "http_transport.h"   // HttpBodySink
+#include <simdjson.h>
+#include <atomic>
+#include <cstdint>
+#include <string>
+
+// ---- Statistik alokasi semua ParseContext (sejak plugin load).
+// Steady state: parses terus naik, semua *Growths berhenti naik.
+struct ParseAllocStats {
+  uint64_t contexts = 0;          // Thread yang pernah parse
+  uint64_t parses = 0;            // Dokumen yang di-iterate
+  uint64_t bufferGrowths = 0;     // Buffer body harus realokasi
+  uint64_t parserGrowths = 0;     // simdjson parser harus realokasi
+  uint64_t transportGrowths = 0;  // Buffer transport (wire, zlib, body respons) harus dialokasi
+};
+ParseAllocStats GetParseAllocStats();
+
+// ---- Konteks parse per thread (worker pool, fetch sinkron, warmup).
+// Memiliki satu simdjson parser dan satu buffer body yang hidup selama thread
+// hidup. Transport men-decode body HTTP langsung ke buffer (ParseContext adalah
+// HttpBodySink, lihat WinHttpGetInto) dengan kapasitas cadangan SIMDJSON_PADDING,
+// jadi iterate() tidak perlu copy ke padded_string. Buffer & parser cuma tumbuh,
+// tidak pernah dikecilkan.
+class ParseContext : public HttpBodySink {
+public:
+  static ParseContext& forThread();
+
+  void begin(const std::string& contentType) override;
+  char* prepare(size_t n) override;
+  void commit(size_t n) override;
+
+  const std::string& body() const { return m_body; }
+  std::string& buffer() { return m_body; }            // Untuk parser streaming (ChartbitStream)
+  simdjson::ondemand::parser& parser() { return m_parser; }
+
+  // Pastikan kapasitas >= size + n + padding; hitung realokasi
+  void reserve(size_t n);
+
+  // Dokumen dari body (tanpa copy), dipakai seperti hasil parser.iterate()
+  simdjson::simdjson_result<simdjson::ondemand::document> iterate();
+  // Dokumen dari potongan buffer [begin, begin + len), sisa buffer jadi padding
+  simdjson::simdjson_result<simdjson::ondemand::document> iterate(size_t begin, size_t len);
+
+private:
+  ParseContext();
+  ParseContext(const ParseContext&) = delete;
+  ParseContext& operator=(const ParseContext&) = delete;
+
+  void noteParserCapacity();
+
+  simdjson::ondemand::parser m_parser;
+  std::string m_body;
+  size_t m_prepared = 0;          // Awal ruang dari prepare() terakhir
+  size_t m_parserCapacity = 0;
+};
+
+#endif // PARSE_CONTEXT_H
@@ -0,0 +1,123 @@
+#include "rate_limiter.h"
+#include "config.h"
+#include <windows.h>
+#include <algorithm>
+#include <thread>
+
+static void LogRate(const std::string& msg) {
+  SYSTEMTIME t;
+  GetLocalTime(&t);
+  char buf[64];
+  sprintf_s(buf, "[%02d:%02d:%02d.%03d] ", t.wHour, t.wMinute, t.wSecond, t.wMilliseconds);
+  OutputDebugStringA((std::string(buf) + "[RateLimiter] " + msg + "\n").c_str());
+}
+
+RateFamily ClassifyApiUrl(const std::string& url) {
+  if (url.find("/historical") != std::string::npos) return RateFamily::HISTORICAL;
+  if (url.find("/ownership") != std::string::npos)  return RateFamily::OWNERSHIP;
+  if (url.find("/financials") != std::string::npos) return RateFamily::FINANCIALS;
+  if (url.find("/ritelflow") != std::string::npos)  return RateFamily::RITELFLOW;
+  return RateFamily::OTHER;
+}
+
+const char* RateFamilyName(RateFamily family) {
+  switch (family) {
+    case RateFamily::HISTORICAL: return "historical";
+    case RateFamily::OWNERSHIP:  return "ownership";
+    case RateFamily::FINANCIALS: return "financials";
+    case RateFamily::RITELFLOW:  return "ritelflow";
+    default:                     return "other";
+  }
+}
+
+RateLimiter& RateLimiter::instance() {
+  static RateLimiter inst;
+  return inst;
+}
+
+RateLimiter::RateLimiter() {
+  const Config& cfg = Config::getInstance();
+  const RateLimitSetting settings[] = {
+    cfg.getRateLimitHistorical(),
+    cfg.getRateLimitOwnership(),
+    cfg.getRateLimitFinancials(),
+    cfg.getRateLimitRitelFlow(),
+  };
+
+  auto now = std::chrono::steady_clock::now();
+  for (int i = 0; i < static_cast<int>(RateFamily::COUNT); i++) {
+    Bucket& b = m_buckets[i];
+    b.last = now;
+    if (i >= static_cast<int>(sizeof(settings) / sizeof(settings[0]))) continue;   // OTHER: tanpa batas
+
+    const RateLimitSetting& s = settings[i];
+    b.baseRate = std::max(0.0, s.requestsPerSec);
+    b.rate = b.baseRate;
+    b.minRate = b.baseRate / 10.0;
+    b.maxRate = b.baseRate * 2.0;
+    b.burst = std::max(1.0, static_cast<double>(s.burst));
+    b.tokens = b.burst;
+    b.targetLatencyMs = std::max(0, s.targetLatencyMs);
+  }
+}
+
+void RateLimiter::refill(Bucket& b, std::chrono::steady_clock::time_point now) {
+  std::chrono::duration<double> elapsed = now - b.last;
+  b.last = now;
+  b.tokens = std::min(b.burst, b.tokens + elapsed.count() * b.rate);
+}
+
+void RateLimiter::acquire(RateFamily family) {
+  Bucket& b = m_buckets[static_cast<int>(family)];
+
+  while (true) {
+    std::chrono::duration<double> wait;
+    {
+      std::lock_guard<std::mutex> lock(m_mtx);
+      if (b.baseRate <= 0.0) return;    // Tidak dibatasi
+
+      refill(b, std::chrono::steady_clock::now());
+      if (b.tokens >= 1.0) {
+        b.tokens -= 1.0;
+        return;
+      }
+      // Tidur sampai token berikutnya terisi (dihitung ulang kalau rate berubah)
+      wait = std::chrono::duration<double>((1.0 - b.tokens) / b.rate);
+    }
+    std::this_thread::sleep_for(std::chrono::duration_cast<std::chrono::milliseconds>(wait) +
+                                std::chrono::milliseconds(1));
+  }
+}
+
+void RateLimiter::report(RateFamily family, int httpStatus, double latencyMs) {
+  Bucket& b = m_buckets[static_cast<int>(family)];
+  std::lock_guard<std::mutex> lock(m_mtx);
+  if (b.baseRate <= 0.0) return;
+
+  refill(b, std::chrono::steady_clock::now());
+  double before = b.rate;
+
+  if (httpStatus == 0 || httpStatus == 429 || httpStatus >= 500) {
+    // Backend kewalahan: potong setengah dan kosongkan burst
+    b.rate = std::max(b.minRate, b.rate * 0.5);
+    b.tokens = std::min(b.tokens, 0.0);
+  } else if (b.targetLatencyMs > 0 && latencyMs > b.targetLatencyMs) {
+    b.rate = std::max(b.minRate, b.rate * 0.85);
+  } else {
+    // Sehat: naik linear 5% dari rate dasar per respons
+    b.rate = std::min(b.maxRate, b.rate + b.baseRate * 0.05);
+  }
+
+  // Log hanya saat turun, atau saat naik melewati rate dasar (hindari spam)
+  if (b.rate < before || (before < b.baseRate && b.rate >= b.baseRate)) {
+    char buf[160];
+    sprintf_s(buf, "%s: status %d, latency %.0f ms -> rate %.2f/s (base %.2f/s)",
+              RateFamilyName(family), httpStatus, latencyMs, b.rate, b.baseRate);
+    LogRate(buf);
+  }
+}
+
+double RateLimiter::currentRate(RateFamily family) const {
+  std::lock_guard<std::mutex> lock(m_mtx);
+  return m_buckets[static_cast<int>(family)].rate;
+}
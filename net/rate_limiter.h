@@ -0,0 +1,60 @@
+#ifndef RATE_LIMITER_H
+#define RATE_LIMITER_H
+
+#include <chrono>
+#include <cstdint>
+#include <mutex>
+#include <string>
+
+// ---- Keluarga endpoint backend (dibedakan dari path URL)
+enum class RateFamily : uint8_t {
+  HISTORICAL,     // /api/amibroker/historical
+  OWNERSHIP,      // /api/amibroker/ownership
+  FINANCIALS,     // /api/amibroker/financials
+  RITELFLOW,      // /api/amibroker/ritelflow
+  OTHER,          // socketkey, emitenlist, dll: tidak dibatasi
+  COUNT
+};
+
+RateFamily ClassifyApiUrl(const std::string& url);
+const char* RateFamilyName(RateFamily family);
+
+// ---- Token bucket adaptif per keluarga endpoint (AIMD).
+// Rate dasar, burst, dan target latency dari config. Rate efektif turun
+// setengah saat 429/5xx/gagal koneksi, turun sedikit kalau latency di atas
+// target, dan naik pelan lagi (sampai 2x rate dasar) selama respons sehat.
+class RateLimiter {
+public:
+  static RateLimiter& instance();
+
+  // Blok sampai ada token untuk keluarga ini
+  void acquire(RateFamily family);
+
+  // Laporan hasil request: httpStatus 0 = gagal di level transport
+  void report(RateFamily family, int httpStatus, double latencyMs);
+
+  double currentRate(RateFamily family) const;
+
+private:
+  RateLimiter();
+  RateLimiter(const RateLimiter&) = delete;
+  RateLimiter& operator=(const RateLimiter&) = delete;
+
+  struct Bucket {
+    double baseRate = 0.0;        // Request per detik dari config (0 = tanpa batas)
+    double rate = 0.0;            // Rate efektif saat ini
+    double minRate = 0.0;
+    double maxRate = 0.0;
+    double burst = 1.0;
+    double tokens = 1.0;
+    double targetLatencyMs = 0.0;
+    std::chrono::steady_clock::time_point last;
+  };
+
+  void refill(Bucket& b, std::chrono::steady_clock::time_point now);
+
+  mutable std::mutex m_mtx;
+  Bucket m_buckets[static_cast<int>(RateFamily::COUNT)];
+};
+
+#endif // RATE_LIMITER_H
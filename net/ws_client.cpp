@@ -16,6 +16,7 @@
 #include "feed.pb.h"
 #include "pong.pb.h"
 #include "config.h"
+#include "refresh_notifier.h"
 
 // ---- INCLUDE UNTUK OLE / COM ----
 #include <vector>
@@ -212,10 +213,6 @@ void WsClient::run() {
 
   std::atomic<bool> isSubscribed{false};
 
-  // ---- THROTTLING ----
-  auto last_ui_update = std::chrono::steady_clock::now();
-  const auto ui_update_interval = std::chrono::milliseconds(100); // 10x per detik
-
   m_ws->setOnMessageCallback([&](const ix::WebSocketMessagePtr& msg) {
     if (msg->type == ix::WebSocketMessageType::Open) {
       LogWS("[WS] ==> EVENT: Open. Connection established.");
@@ -274,16 +271,9 @@ void WsClient::run() {
 
             // 4. Proses jika decode berhasil DAN sub-pesan stock_data ada isinya
             if (status && feed.has_stock_data) {
-                gDataStore.updateLiveQuote(feed); // Kirim struct nanopb ke DataStore
-                // if (m_hAmiBrokerWnd) PostMessage(m_hAmiBrokerWnd, WM_USER_STREAMING_UPDATE, 0, 0);
-                auto now = std::chrono::steady_clock::now();
-                if (now - last_ui_update > ui_update_interval) 
-                {
-                    if (m_hAmiBrokerWnd) {
-                        PostMessage(m_hAmiBrokerWnd, WM_USER_STREAMING_UPDATE, 0, 0);
-                    }
-                    last_ui_update = now; // Reset timer
-                }
+                SymbolId id = gDataStore.updateLiveQuote(feed); // Kirim struct nanopb ke DataStore
+                // Refresh chart digabung & dibatasi oleh RefreshNotifier
+                if (id != kNoSymbol) RefreshNotifier::instance().signal(id);
             } else {
                 if (msg->str.size() < 12) {
                     return;     // heartbeat / pong
@@ -39,7 +39,6 @@ private:
   std::string buildSubscribeBinary(const std::string& userId, const std::string& key, const std::vector<std::string>& symbols);
 
   //std::vector<std::string> loadSymbols(const std::string& path = "symbols.txt");    // Subscribe symbols berbasis file
-  std::vector<std::string> getDBSymbols();                                            // Subscribe berbasis DB
 
 
 public:
@@ -52,6 +51,10 @@ public:
 
   // Metode untuk menghubungkan dengan plugin
   void setAmiBrokerWindow(HWND hWnd, std::atomic<int>* pStatus);
+
+  // Daftar ticker di database AmiBroker via OLE (Broker.Application).
+  // Static supaya bisa dipakai juga oleh warmup, tidak butuh koneksi WS.
+  static std::vector<std::string> getDBSymbols();
 };
 
 #endif // WS_CLIENT_H
\ No newline at end of file
@@ -1,7 +1,10 @@
 #include "plugin.h"
 #include "ws_client.h"
 #include "data_store.h"
+#include "bar_cache.h"
 #include "ami_bridge.h"
+#include "warmup.h"
+#include "refresh_notifier.h"
 #include "resource.h"
 #include "pluginstate.h"
 #include "config.h"
@@ -28,9 +31,6 @@ HMODULE g_hDllModule = NULL;                      // DLL handle
 
 std::atomic<int> g_nStatus = STATE_IDLE;
 
-// ---- Worker Thread ----
-std::thread g_workerThread;
-std::atomic<bool> g_bWorkerThreadRun = false;     // Background thread
 
 // ---- DllMain Entry Point ----
 BOOL APIENTRY DllMain(HMODULE hModule, DWORD ul_reason_for_call, LPVOID lpReserved) {
@@ -125,23 +125,15 @@ PLUGINAPI int Init(void) {
 }
 
 PLUGINAPI int Release(void) {
-  // Stop worker thread
-  if (g_bWorkerThreadRun) {
-    g_bWorkerThreadRun = false;
-
-    // BANGUNKAN WORKER SUPAYA DIA BISA EXIT
-    g_fetchQueueCV.notify_one();
-
-    if (g_workerThread.joinable()) {
-      g_workerThread.join();
-    }
-    OutputDebugStringA("[Plugin] Fetcher worker thread stopped.");
-  }
+  // Stop warmup dulu (dia menunggu future dari pool), lalu worker pool
+  Warmup::instance().stop();
+  StopFetchWorkers();
 
   if (g_wsClient) {
       g_wsClient->stop();
   }
   g_wsClient.reset();
+  RefreshNotifier::instance().stop();     // Setelah semua producer berhenti
   g_nStatus = STATE_IDLE;
   return 1;
 }
@@ -150,9 +142,13 @@ PLUGINAPI struct RecentInfo* GetRecentInfo(LPCTSTR pszTicker) {
   static RecentInfo ri;
   memset(&ri, 0, sizeof(ri));
 
-  LiveQuote q = gDataStore.getLiveQuote(pszTicker);
-
-  if (q.symbol.empty()) return nullptr;
+  // Snapshot immutable, lock-free (tidak menunggu callback WS).
+  // find() tidak meng-intern: ticker yang belum pernah muncul di feed langsung null.
+  SymbolId id = SymbolTable::instance().find(pszTicker);
+  if (id == kNoSymbol) return nullptr;
+  auto snapshot = gDataStore.getLiveQuote(id);
+  if (!snapshot) return nullptr;
+  const LiveQuote& q = *snapshot;
 
   strcpy_s(ri.Name, sizeof(ri.Name), q.symbol.c_str());
   ri.nStructSize = sizeof(RecentInfo);
@@ -199,6 +195,19 @@ PLUGINAPI int GetStatus(struct PluginStatus* status) {
           status->clrStatusColor = RGB(255, 0, 0);
           break;
   }
+
+  // ---- Progress warmup ditempel di pesan panjang
+  Warmup::Progress wp = Warmup::instance().progress();
+  if (wp.running && wp.total > 0) {
+    char warmup[96];
+    if (wp.etaSeconds >= 0) {
+      sprintf_s(warmup, " Warmup %d/%d (%d%%), ETA %dm %02ds.", wp.done, wp.total,
+                wp.done * 100 / wp.total, wp.etaSeconds / 60, wp.etaSeconds % 60);
+    } else {
+      sprintf_s(warmup, " Warmup %d/%d.", wp.done, wp.total);
+    }
+    strcat_s(status->szLongMessage, warmup);
+  }
   return 1;
 }
 
@@ -209,12 +218,21 @@ PLUGINAPI int Notify(struct PluginNotification* pn) {
       g_wsClient->setAmiBrokerWindow(g_hAmiBrokerWnd, &g_nStatus);
     }
 
-    // ---- START WORKER THREAD ----
-    if (!g_bWorkerThreadRun) {
-      g_bWorkerThreadRun = true;
-      g_workerThread = std::thread(ProcessFetchQueue);                  // Fungsi ini ada di ami_bridge
-      OutputDebugStringA("[Plugin] Fetcher worker thread started.");
+    // ---- DISK CACHE: default di folder database AmiBroker, bisa override via .env
+    std::string cacheDir = Config::getInstance().getCacheDir();
+    if (cacheDir.empty() && pn->pszDatabasePath) {
+      cacheDir = std::string(pn->pszDatabasePath) + "\\ValkyrieCache";
     }
+    BarCache::setDirectory(cacheDir);
+
+    // ---- REFRESH NOTIFIER: satu-satunya jalur refresh chart ke AmiBroker
+    RefreshNotifier::instance().start(g_hAmiBrokerWnd, Config::getInstance().getRefreshIntervalMs());
+
+    // ---- START WORKER POOL ----
+    StartFetchWorkers();                // Ada di ami_bridge; no-op kalau sudah jalan
+
+    // ---- WARMUP (opsional): prefetch simbol DB di background
+    Warmup::instance().start(Config::getInstance().getWarmupMode(), Config::getInstance().getWarmupBatch());
   }
 
   if (pn->nReason == REASON_DATABASE_UNLOADED) {
@@ -222,19 +240,12 @@ PLUGINAPI int Notify(struct PluginNotification* pn) {
       g_wsClient->stop();
     }
 
-    // ---- STOP WORKER THREAD ----
-    if (g_bWorkerThreadRun) {
-      g_bWorkerThreadRun = false;
-
-      // BANGUNKAN WORKER SUPAYA DIA BISA EXIT
-      g_fetchQueueCV.notify_one();
-
-      if (g_workerThread.joinable()) {
-        g_workerThread.join();
-      }
-      OutputDebugStringA("[Plugin] Fetcher worker thread stopped.");
-    }
+    // ---- STOP WARMUP & WORKER POOL ----
+    Warmup::instance().stop();
+    StopFetchWorkers();
+    RefreshNotifier::instance().stop();
 
+    BarCache::setDirectory("");
     g_hAmiBrokerWnd = NULL;
   }
     
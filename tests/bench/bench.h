@@ -0,0 +1,88 @@
+#ifndef TESTS_BENCH_H
+#define TESTS_BENCH_H
+
+// ---- Harness benchmark minimal. BENCH mendaftar fungsi per request backlog;
+// Quick() = ukuran kecil (dipakai ctest supaya bench tetap dikompilasi & jalan).
+#include <chrono>
+#include <cstdio>
+#include <string>
+#include <vector>
+
+namespace bench {
+
+struct Entry {
+  const char* id;
+  const char* title;
+  void (*fn)();
+};
+
+inline std::vector<Entry>& registry() {
+  static std::vector<Entry> entries;
+  return entries;
+}
+
+struct Registrar {
+  Registrar(const char* id, const char* title, void (*fn)()) { registry().push_back({ id, title, fn }); }
+};
+
+} // namespace bench
+
+class LocalServer;
+
+namespace bench {
+
+bool Quick();
+LocalServer& Server();        // Stand-in server lokal (lihat bench_main.cpp)
+
+// Rata-rata waktu satu panggilan (ns), diulang sampai minimal ~minMs
+template <class Fn>
+double TimeNs(Fn&& fn, double minMs = 200.0) {
+  using clock = std::chrono::steady_clock;
+  if (Quick()) minMs = 5.0;
+  fn();     // Pemanasan
+  size_t iterations = 0;
+  auto t0 = clock::now();
+  std::chrono::duration<double, std::nano> elapsed{0};
+  do {
+    fn();
+    iterations++;
+    elapsed = clock::now() - t0;
+  } while (elapsed.count() < minMs * 1e6);
+  return elapsed.count() / static_cast<double>(iterations);
+}
+
+// Untuk fn yang mengubah input-nya (merge in-place dsb.): tiap putaran setup(i)
+// menyiapkan 'batch' input segar di luar jam, lalu hanya fn(0..batch-1) yang diukur.
+// Return rata-rata ns per panggilan fn.
+template <class Setup, class Fn>
+double TimeBatchNs(size_t batch, Setup&& setup, Fn&& fn, double minMs = 200.0) {
+  using clock = std::chrono::steady_clock;
+  if (Quick()) minMs = 5.0;
+  size_t calls = 0;
+  std::chrono::duration<double, std::nano> timed{0};
+  do {
+    for (size_t i = 0; i < batch; i++) setup(i);
+    auto t0 = clock::now();
+    for (size_t i = 0; i < batch; i++) fn(i);
+    timed += clock::now() - t0;
+    calls += batch;
+  } while (timed.count() < minMs * 1e6);
+  return timed.count() / static_cast<double>(calls);
+}
+
+// Cegah compiler membuang hasil yang tidak dipakai
+template <class T>
+inline void Keep(const T& value) {
+  asm volatile("" : : "g"(&value) : "memory");
+}
+
+} // namespace bench
+
+#define BENCH_CONCAT_(a, b) a##b
+#define BENCH_CONCAT(a, b) BENCH_CONCAT_(a, b)
+#define BENCH(id, title)                                                             \
+  static void BENCH_CONCAT(bench_fn_, __LINE__)();                                   \
+  static bench::Registrar BENCH_CONCAT(bench_reg_, __LINE__)(id, title, &BENCH_CONCAT(bench_fn_, __LINE__)); \
+  static void BENCH_CONCAT(bench_fn_, __LINE__)()
+
+#endif // TESTS_BENCH_H
@@ -0,0 +1,274 @@
+#include "bench.h"
+#include "bar_series.h"
+#include "civil_date.h"
+#include "data_store.h"
+#include "fixtures.h"
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
+#include <ctime>
+#include <iomanip>
+#include <map>
+#include <mutex>
+#include <sstream>
+
+// ---- Layout & fungsi lama (baseline), disalin apa adanya untuk pembanding
+struct LegacyCandle {
+  std::string date;
+  double open, high, low, close, volume, frequency, value, netforeign;
+};
+
+static std::vector<LegacyCandle> ToLegacy(const std::vector<SourceBar>& bars) {
+  std::vector<LegacyCandle> out;
+  for (const SourceBar& b : bars) {
+    out.push_back({ IsoDate(b.day), (double)b.open, (double)b.high, (double)b.low, (double)b.close, (double)b.volume,
+                    (double)b.frequency, (double)b.value, (double)(b.foreignBuy - b.foreignSell) });
+  }
+  return out;
+}
+
+// DataStore lama: satu mutex, std::map<string, vector<Candle>>, getHistorical mengembalikan copy
+class LegacyCandleStore {
+public:
+  void setHistorical(const std::string& symbol, const std::vector<LegacyCandle>& candles) {
+    std::lock_guard<std::mutex> lock(m_mtx);
+    m_historicalData[symbol] = candles;
+  }
+  std::vector<LegacyCandle> getHistorical(const std::string& symbol) {
+    std::lock_guard<std::mutex> lock(m_mtx);
+    auto it = m_historicalData.find(symbol);
+    return it == m_historicalData.end() ? std::vector<LegacyCandle>() : it->second;
+  }
+
+private:
+  std::mutex m_mtx;
+  std::map<std::string, std::vector<LegacyCandle>> m_historicalData;
+};
+
+// DataStore::mergeHistorical lama: rebuild lewat std::map<string, Candle>
+static void LegacyMerge(std::vector<LegacyCandle>& existing, const std::vector<LegacyCandle>& incoming) {
+  std::map<std::string, LegacyCandle> merged_map;
+  for (const auto& c : existing) merged_map[c.date] = c;
+  for (const auto& c : incoming) merged_map[c.date] = c;
+  std::vector<LegacyCandle> final_candles;
+  final_candles.reserve(merged_map.size());
+  for (const auto& pair : merged_map) final_candles.push_back(pair.second);
+  existing = final_candles;
+}
+
+// GetQuotesEx lama: ambil copy Candle dari store, lalu sscanf + narrowing per bar
+static int LegacyCopyOut(LegacyCandleStore& store, const std::string& symbol, Quotation* pQuotes, int nSize) {
+  std::vector<LegacyCandle> final_candles = store.getHistorical(symbol);
+  size_t numToCopy = std::min<size_t>(final_candles.size(), static_cast<size_t>(nSize));
+  size_t startIndex = final_candles.size() - numToCopy;
+  for (size_t i = 0; i < numToCopy; ++i) {
+    const auto& candle = final_candles[startIndex + i];
+    Quotation& qt = pQuotes[i];
+    qt.DateTime.Date = 0;
+    int year, month, day;
+    if (sscanf(candle.date.c_str(), "%d-%d-%d", &year, &month, &day) == 3) {
+      qt.DateTime.PackDate.Year = year;
+      qt.DateTime.PackDate.Month = month;
+      qt.DateTime.PackDate.Day = day;
+      qt.DateTime.PackDate.Minute = DATE_EOD_MINUTES;
+      qt.DateTime.PackDate.Hour = DATE_EOD_HOURS;
+    }
+    qt.Price = static_cast<float>(candle.close);
+    qt.Open = static_cast<float>(candle.open);
+    qt.High = static_cast<float>(candle.high);
+    qt.Low = static_cast<float>(candle.low);
+    qt.Volume = static_cast<float>(candle.volume);
+    qt.OpenInterest = static_cast<float>(candle.frequency);
+    qt.AuxData1 = static_cast<float>(candle.value);
+    qt.AuxData2 = static_cast<float>(candle.netforeign);
+  }
+  return static_cast<int>(numToCopy);
+}
+
+// GetQuotesEx baru: baris Quotation dari DataStore, satu memcpy
+static int StoreCopyOut(DataStore& store, SymbolId symbol, Quotation* pQuotes, int nSize) {
+  std::shared_ptr<const BarSeries> series = store.getHistorical(symbol);
+  const std::vector<Quotation>& final_bars = series->bars;
+  size_t numToCopy = std::min<size_t>(final_bars.size(), static_cast<size_t>(nSize));
+  memcpy(pQuotes, final_bars.data() + final_bars.size() - numToCopy, numToCopy * sizeof(Quotation));
+  return static_cast<int>(numToCopy);
+}
+
+BENCH("user-001", "copy-out GetQuotesEx: store Candle + sscanf lama vs store baris Quotation") {
+  const size_t n = 5000;
+  auto src = MakeSourceBars(DayOf(2005, 1, 3), n);
+  auto bars = ToQuotations(src);
+  std::vector<Quotation> pQuotes(n);
+
+  LegacyCandleStore legacy;
+  legacy.setHistorical("BBCA", ToLegacy(src));
+  static DataStore store;     // Slot array besar: jangan di stack
+  const SymbolId id = SymbolTable::instance().intern("BBCA");
+  store.setHistorical(id, bars);
+
+  double oldNs = bench::TimeNs([&] { bench::Keep(LegacyCopyOut(legacy, "BBCA", pQuotes.data(), (int)n)); });
+  std::vector<Quotation> legacyOut = pQuotes;
+  double newNs = bench::TimeNs([&] { bench::Keep(StoreCopyOut(store, id, pQuotes.data(), (int)n)); });
+
+  printf("  %zu bars: old %.1f us, new %.1f us (%.1fx); per bar old %.1f ns, new %.2f ns\n",
+         n, oldNs / 1e3, newNs / 1e3, oldNs / newNs, oldNs / n, newNs / n);
+  printf("  store %zu B/bar (Candle, tanggal std::string) vs %zu B/bar (Quotation)\n", sizeof(LegacyCandle), sizeof(Quotation));
+  printf("  rows identical to old copy-out: %s\n", SameBars(legacyOut, pQuotes) && SameBars(pQuotes, bars) ? "yes" : "NO");
+}
+
+BENCH("user-004", "merge 5000 bar + delta 3 bar: rebuild std::map vs SpliceBars") {
+  const size_t n = 5000;
+  auto src = MakeSourceBars(DayOf(2005, 1, 3), n + 2);
+  std::vector<SourceBar> baseSrc(src.begin(), src.begin() + n);
+  std::vector<SourceBar> deltaSrc(src.end() - 3, src.end());    // 1 overlap + 2 bar baru
+  for (auto& b : deltaSrc) b.close += 7;
+
+  auto legacyBase = ToLegacy(baseSrc);
+  auto legacyDelta = ToLegacy(deltaSrc);
+  auto base = ToQuotations(baseSrc);
+  auto delta = ToQuotations(deltaSrc);
+
+  // Merge lama mengubah vector tersimpan: tiap panggilan dapat copy segar (di luar jam)
+  const size_t batch = 8;
+  std::vector<std::vector<LegacyCandle>> work(batch);
+  double oldNs = bench::TimeBatchNs(batch, [&](size_t i) { work[i] = legacyBase; },
+                                    [&](size_t i) { LegacyMerge(work[i], legacyDelta); bench::Keep(work[i].size()); });
+
+  std::vector<Quotation> out;
+  double spliceNs = bench::TimeNs([&] {
+    SpliceBars(base, delta, out);
+    bench::Keep(out.size());
+  });
+
+  printf("  old std::map rebuild: %.1f us\n", oldNs / 1e3);
+  printf("  SpliceBars (new vector): %.1f us (%.0fx)\n", spliceNs / 1e3, oldNs / spliceNs);
+  printf("  result: %zu bars, last close %.0f, same rows as old merge: %s\n", out.size(), out.back().Price,
+         out.size() == work[0].size() && out.back().Price == static_cast<float>(work[0].back().close) ? "yes" : "NO");
+}
+
+BENCH("user-012", "merge delta ke buffer AmiBroker: MergeBarsInPlace vs SpliceBars + memcpy vs std::map lama") {
+  const size_t n = 5000;
+  auto src = MakeSourceBars(DayOf(2005, 1, 3), n + 2);
+  std::vector<SourceBar> baseSrc(src.begin(), src.begin() + n);
+  std::vector<SourceBar> deltaSrc(src.end() - 3, src.end());    // 1 overlap + 2 bar baru
+  for (auto& b : deltaSrc) b.close += 7;
+
+  auto legacyBase = ToLegacy(baseSrc);
+  auto legacyDelta = ToLegacy(deltaSrc);
+  auto base = ToQuotations(baseSrc);
+  auto delta = ToQuotations(deltaSrc);
+
+  // Semua varian mengubah input: buffer/vector segar disiapkan per panggilan di luar jam
+  const size_t batch = 16;
+  std::vector<std::vector<LegacyCandle>> legacyWork(batch);
+  double oldNs = bench::TimeBatchNs(batch, [&](size_t i) { legacyWork[i] = legacyBase; },
+                                    [&](size_t i) { LegacyMerge(legacyWork[i], legacyDelta); bench::Keep(legacyWork[i].size()); });
+
+  std::vector<std::vector<Quotation>> pQuotes(batch, std::vector<Quotation>(n + 3));
+  std::vector<Quotation> spliced;
+  double spliceNs = bench::TimeBatchNs(batch, [&](size_t i) { memcpy(pQuotes[i].data(), base.data(), n * sizeof(Quotation)); },
+                                       [&](size_t i) {
+                                         SpliceBars(std::vector<Quotation>(pQuotes[i].begin(), pQuotes[i].begin() + n), delta, spliced);
+                                         memcpy(pQuotes[i].data(), spliced.data(), spliced.size() * sizeof(Quotation));
+                                         bench::Keep(pQuotes[i][0]);
+                                       });
+  int merged = 0;
+  double inPlaceNs = bench::TimeBatchNs(batch, [&](size_t i) { memcpy(pQuotes[i].data(), base.data(), n * sizeof(Quotation)); },
+                                        [&](size_t i) { merged = MergeBarsInPlace(pQuotes[i].data(), (int)n, (int)n + 3, delta.data(), delta.size()); });
+
+  SpliceBars(base, delta, spliced);
+  const bool same = merged == (int)spliced.size() && SameBars(std::vector<Quotation>(pQuotes[0].begin(), pQuotes[0].begin() + merged), spliced);
+  printf("  old std::map rebuild:         %8.2f us\n", oldNs / 1e3);
+  printf("  SpliceBars + copy to pQuotes: %8.2f us\n", spliceNs / 1e3);
+  printf("  MergeBarsInPlace:             %8.2f us (%.0fx vs std::map, %.1fx vs Splice+copy), hasil sama: %s\n",
+         inPlaceNs / 1e3, oldNs / inPlaceNs, spliceNs / inPlaceNs, same ? "yes" : "NO");
+}
+
+// ---- user-025: konversi tanggal lama (mktime / sscanf / iostream) vs civil_date
+static DATE_TIME_INT LegacyAmiDateToUnix(DATE_TIME_INT amiDate) {
+  AmiDate dateUnion;
+  dateUnion.Date = amiDate;
+  std::tm tm = {};
+  tm.tm_year = dateUnion.PackDate.Year - 1900;
+  tm.tm_mon = dateUnion.PackDate.Month - 1;
+  tm.tm_mday = dateUnion.PackDate.Day;
+  tm.tm_isdst = -1;
+  return (DATE_TIME_INT)std::mktime(&tm);
+}
+
+static time_t LegacyStringToUnix(const std::string& date_str) {
+  int y, m, d;
+  if (sscanf(date_str.c_str(), "%d-%d-%d", &y, &m, &d) != 3) return 0;
+  std::tm tm = {};
+  tm.tm_year = y - 1900;
+  tm.tm_mon = m - 1;
+  tm.tm_mday = d;
+  tm.tm_isdst = -1;
+  return std::mktime(&tm);
+}
+
+static std::chrono::system_clock::time_point LegacyStringToTimePoint(const std::string& date_str) {
+  std::tm tm = {};
+  std::stringstream ss(date_str);
+  ss >> std::get_time(&tm, "%Y-%m-%d");
+  return std::chrono::system_clock::from_time_t(std::mktime(&tm));
+}
+
+static std::string LegacyTimePointToString(const std::chrono::system_clock::time_point& tp) {
+  std::time_t tt = std::chrono::system_clock::to_time_t(tp);
+  std::tm tm = *std::localtime(&tt);
+  std::stringstream ss;
+  ss << std::put_time(&tm, "%Y-%m-%d");
+  return ss.str();
+}
+
+BENCH("user-025", "konversi tanggal: mktime/sscanf/get_time lama vs civil_date") {
+  // Mesin plugin jalan di WIB; fungsi lama bergantung zona mesin, civil_date tidak
+  setenv("TZ", "Asia/Jakarta", 1);
+  tzset();
+
+  const int32_t first = DayOf(1995, 1, 1);
+  const int32_t count = bench::Quick() ? 500 : 12000;
+  std::vector<DATE_TIME_INT> packed;
+  std::vector<std::string> iso;
+  char buf[11];
+  for (int32_t d = first; d < first + count; d++) {
+    packed.push_back(DaysToEodDate(d));
+    CivilDate::FormatIsoDate(d, buf);
+    iso.push_back(buf);
+  }
+
+  // Kecocokan hasil untuk semua tanggal
+  int mismatches = 0;
+  for (int32_t i = 0; i < count; i++) {
+    int64_t unixNew = EodDateToUnix(packed[i]);
+    if ((int64_t)LegacyAmiDateToUnix(packed[i]) != unixNew) mismatches++;
+    if ((int64_t)LegacyStringToUnix(iso[i]) != unixNew) mismatches++;
+    if (LegacyTimePointToString(LegacyStringToTimePoint(iso[i])) != iso[i]) mismatches++;
+    DATE_TIME_INT parsed = 0;
+    if (!ParseEodDate(iso[i], parsed) || parsed != packed[i]) mismatches++;
+  }
+
+  size_t i = 0;
+  auto next = [&] { i = (i + 1) % packed.size(); return i; };
+  double amiOld = bench::TimeNs([&] { bench::Keep(LegacyAmiDateToUnix(packed[next()])); });
+  double amiNew = bench::TimeNs([&] { bench::Keep(EodDateToUnix(packed[next()])); });
+  double strOld = bench::TimeNs([&] { bench::Keep(LegacyStringToUnix(iso[next()])); });
+  double strNew = bench::TimeNs([&] {
+    int32_t d = 0;
+    CivilDate::ParseIsoDate(iso[next()], d);
+    bench::Keep(CivilDate::UnixFromDays(d));
+  });
+  double rtOld = bench::TimeNs([&] { bench::Keep(LegacyTimePointToString(LegacyStringToTimePoint(iso[next()]))); });
+  double rtNew = bench::TimeNs([&] {
+    int32_t d = 0;
+    CivilDate::ParseIsoDate(iso[next()], d);
+    CivilDate::FormatIsoDate(d + 1, buf);
+    bench::Keep(buf[0]);
+  });
+
+  printf("  TZ=Asia/Jakarta, %d dates 1995+, mismatches vs old functions: %d\n", count, mismatches);
+  printf("  AmiDateToUnix (mktime)        %7.1f ns -> EodDateToUnix      %5.1f ns (%.0fx)\n", amiOld, amiNew, amiOld / amiNew);
+  printf("  StringToUnix (sscanf+mktime)  %7.1f ns -> ParseIsoDate+Unix  %5.1f ns (%.0fx)\n", strOld, strNew, strOld / strNew);
+  printf("  get_time + put_time roundtrip %7.1f ns -> Parse+FormatIso   %5.1f ns (%.0fx)\n", rtOld, rtNew, rtOld / rtNew);
+}
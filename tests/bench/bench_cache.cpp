@@ -0,0 +1,26 @@
+#include "bench.h"
+#include "bar_cache.h"
+#include "bar_file.h"
+#include "fixtures.h"
+#include <filesystem>
+#include <string>
+#include <unistd.h>
+
+BENCH("user-006", "restart: load cache disk (mmap) vs simpan ulang") {
+  const size_t n = 5000;
+  auto bars = ToQuotations(MakeSourceBars(DayOf(2005, 1, 3), n));
+  const std::string dir = (std::filesystem::temp_directory_path() / ("valkyrie_bench_" + std::to_string(getpid()))).string();
+  BarCache::setDirectory(dir);
+  BarCache::save("BBCA", bars);
+
+  std::vector<Quotation> loaded;
+  double loadNs = bench::TimeNs([&] { BarCache::load("BBCA", loaded); });
+  double saveNs = bench::TimeNs([&] { BarCache::save("BBCA", bars); }, 50.0);
+
+  printf("  %zu bars, file %zu B: load %.1f us, save (tmp + rename) %.1f us\n",
+         n, sizeof(BarFileHeader) + n * sizeof(Quotation), loadNs / 1e3, saveNs / 1e3);
+  printf("  rows identical after load: %s\n", SameBars(loaded, bars) ? "yes" : "NO");
+  std::error_code ec;
+  std::filesystem::remove_all(dir, ec);
+  BarCache::setDirectory("");
+}
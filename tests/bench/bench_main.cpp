@@ -0,0 +1,46 @@
+#include "bench.h"
+#include "local_server.h"
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <thread>
+
+static bool g_quick = false;
+static LocalServer* g_server = nullptr;
+
+bool bench::Quick() {
+  return g_quick;
+}
+
+LocalServer& bench::Server() {
+  return *g_server;
+}
+
+// Pemakaian: valkyrie_bench [--quick] [id...]   (id = user-001, user-004, ...)
+int main(int argc, char** argv) {
+  std::vector<std::string> only;
+  for (int i = 1; i < argc; i++) {
+    if (strcmp(argv[i], "--quick") == 0) g_quick = true;
+    else only.push_back(argv[i]);
+  }
+
+  LocalServer server([](const ServedRequest&) { return ServedResponse(); });
+  g_server = &server;
+  setenv("PLUGIN_HOST", server.url().c_str(), 1);
+  setenv("PLUGIN_USERNAME", "bench", 1);
+  setenv("PLUGIN_SOCKET", "ws://127.0.0.1:1", 1);
+  for (const char* key : { "PLUGIN_RATE_HISTORICAL", "PLUGIN_RATE_OWNERSHIP", "PLUGIN_RATE_FINANCIALS", "PLUGIN_RATE_RITELFLOW" }) {
+    setenv(key, "0,1,60000", 1);    // Ukur transport & parser, bukan pacing
+  }
+
+  printf("valkyrie_bench%s, %u hardware thread(s)\n", g_quick ? " (quick)" : "", std::thread::hardware_concurrency());
+  for (const auto& entry : bench::registry()) {
+    bool selected = only.empty();
+    for (const auto& id : only) selected = selected || id == entry.id;
+    if (!selected) continue;
+    printf("\n[%s] %s\n", entry.id, entry.title);
+    fflush(stdout);
+    entry.fn();
+  }
+  return 0;
+}
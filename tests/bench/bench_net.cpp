@@ -0,0 +1,143 @@
+#include "bench.h"
+#include "api_client.h"
+#include "config.h"
+#include "fixtures.h"
+#include "historical_proto.h"
+#include "http_transport.h"
+#include "local_server.h"
+#include <atomic>
+#include <string>
+
+using namespace std::chrono;
+
+static double SecondsSince(steady_clock::time_point t0) {
+  return duration<double>(steady_clock::now() - t0).count();
+}
+
+static ServedResponse Prebuilt(const std::string& gzBody, const char* contentType = "application/json") {
+  ServedResponse r;
+  r.contentType = contentType;
+  r.body = gzBody;
+  r.encoding = "gzip";
+  r.bodyEncoded = true;
+  return r;
+}
+
+BENCH("user-019", "koneksi keep-alive dipakai ulang vs koneksi baru per request") {
+  const int requests = bench::Quick() ? 100 : 3000;
+  const std::string url = Config::getInstance().getHost() + "/api/amibroker/emitenlist";
+  HttpResponse res;
+  for (bool close : { true, false }) {
+    bench::Server().setHandler([&](const ServedRequest&) {
+      ServedResponse r;
+      r.body = std::string(512, 'x');
+      r.closeAfter = close;
+      return r;
+    });
+    DefaultHttpTransport().get(url, 2000, res);     // Pemanasan (socket idle di pool)
+    bench::Server().resetCounters();
+    auto t0 = steady_clock::now();
+    int ok = 0;
+    for (int i = 0; i < requests; i++) ok += DefaultHttpTransport().get(url, 2000, res) && res.status == 200;
+    double sec = SecondsSince(t0);
+    printf("  %-28s %5d req in %.3f s = %7.0f req/s, %.1f us/req, %d TCP connection(s), %d ok\n",
+           close ? "Connection: close (old)" : "keep-alive pool (new)", requests, sec, requests / sec,
+           sec * 1e6 / requests, bench::Server().connections(), ok);
+  }
+}
+
+BENCH("user-020", "byte wire vs hasil decode (gzip) untuk body historical JSON") {
+  const size_t n = 5000;
+  const std::string json = ChartbitJson(MakeSourceBars(DayOf(2005, 1, 3), n));
+  const std::string url = Config::getInstance().getHost() + "/api/amibroker/historical?symbol=BBCA";
+  HttpResponse res;
+
+  for (const char* encoding : { "", "gzip", "deflate" }) {
+    const std::string wire = *encoding ? Compress(json, encoding) : json;
+    bench::Server().setHandler([&](const ServedRequest&) {
+      ServedResponse r;
+      r.body = wire;
+      r.encoding = encoding;
+      r.bodyEncoded = true;
+      r.chunked = true;
+      return r;
+    });
+    const HttpTransferTotals before = GetHttpTransferTotals();
+    double ns = bench::TimeNs([&] { DefaultHttpTransport().get(url, 5000, res); }, 100.0);
+    const HttpTransferTotals after = GetHttpTransferTotals();
+    const double responses = static_cast<double>(after.responses - before.responses);
+    printf("  %-8s wire %7zu B, decoded %7zu B (%.1f%% of decoded), totals/response wire %.0f B decoded %.0f B, "
+           "fetch+inflate %.2f ms, body ok: %s\n",
+           *encoding ? encoding : "identity", res.wireBytes, res.body.size(), 100.0 * res.wireBytes / res.body.size(),
+           (after.wireBytes - before.wireBytes) / responses, (after.decodedBytes - before.decodedBytes) / responses,
+           ns / 1e6, res.body == json ? "yes" : "NO");
+  }
+}
+
+BENCH("user-024", "historical 900 simbol x 500 bar: JSON vs protobuf (byte wire & waktu decode)") {
+  const int symbols = bench::Quick() ? 20 : 900;
+  const size_t barsPerSymbol = 500;
+  struct Payload {
+    std::vector<Quotation> expected;
+    std::string json, jsonGz, proto, protoGz;
+  };
+  std::vector<Payload> payloads(symbols);
+  size_t jsonBytes = 0, jsonGzBytes = 0, protoBytes = 0, protoGzBytes = 0;
+  for (int s = 0; s < symbols; s++) {
+    auto src = MakeSourceBars(DayOf(2022, 1, 3), barsPerSymbol, s + 1);
+    Payload& p = payloads[s];
+    p.expected = ToQuotations(src);
+    p.json = ChartbitJson(src);
+    p.proto = HistoricalProto(src);
+    p.jsonGz = Compress(p.json, "gzip");
+    p.protoGz = Compress(p.proto, "gzip");
+    jsonBytes += p.json.size();
+    jsonGzBytes += p.jsonGz.size();
+    protoBytes += p.proto.size();
+    protoGzBytes += p.protoGz.size();
+  }
+  printf("  %d symbols x %zu bars, total body: JSON %.2f MB (gzip %.2f MB), protobuf %.2f MB (gzip %.2f MB)\n",
+         symbols, barsPerSymbol, jsonBytes / 1e6, jsonGzBytes / 1e6, protoBytes / 1e6, protoGzBytes / 1e6);
+  printf("  protobuf/JSON: raw %.1f%%, gzip %.1f%%\n", 100.0 * protoBytes / jsonBytes, 100.0 * protoGzBytes / jsonGzBytes);
+
+  // Decode murni (tanpa jaringan)
+  std::vector<Quotation> out;
+  auto t0 = steady_clock::now();
+  int decodeMismatch = 0;
+  for (const Payload& p : payloads) {
+    if (!DecodeHistoricalBars(p.proto.data(), p.proto.size(), out) || !SameBars(out, p.expected)) decodeMismatch++;
+  }
+  double decodeSec = SecondsSince(t0);
+  printf("  DecodeHistoricalBars: %.1f ms total, %.1f us/symbol, %.1f ns/bar\n", decodeSec * 1e3,
+         decodeSec * 1e6 / symbols, decodeSec * 1e9 / (symbols * barsPerSymbol));
+
+  // End-to-end fetchHistorical (transport + inflate + parse), body gzip sudah disiapkan
+  std::atomic<bool> honourAccept{false};
+  bench::Server().setHandler([&](const ServedRequest& req) {
+    size_t pos = req.path.find("symbol=S");
+    int s = std::atoi(req.path.c_str() + pos + 8);
+    const Payload& p = payloads[s];
+    if (honourAccept && req.accept.find(kHistoricalProtoType) != std::string::npos) return Prebuilt(p.protoGz, kHistoricalProtoType);
+    return Prebuilt(p.jsonGz);
+  });
+
+  double fetchSec[2] = {};
+  int mismatches[2] = {};
+  uint64_t wire[2] = {};
+  for (int format = 0; format < 2; format++) {
+    honourAccept = format == 1;
+    const HttpTransferTotals start = GetHttpTransferTotals();
+    t0 = steady_clock::now();
+    for (int s = 0; s < symbols; s++) {
+      auto bars = fetchHistorical("S" + std::to_string(s), "2022-01-03", "2024-12-31");
+      if (!SameBars(bars, payloads[s].expected)) mismatches[format]++;
+    }
+    fetchSec[format] = SecondsSince(t0);
+    wire[format] = GetHttpTransferTotals().wireBytes - start.wireBytes;
+  }
+  printf("  fetchHistorical JSON:     %.3f s (%.2f ms/symbol), wire %.2f MB, rows mismatching expected: %d\n",
+         fetchSec[0], fetchSec[0] * 1e3 / symbols, wire[0] / 1e6, mismatches[0]);
+  printf("  fetchHistorical protobuf: %.3f s (%.2f ms/symbol), wire %.2f MB, rows mismatching expected: %d (decode-only: %d)\n",
+         fetchSec[1], fetchSec[1] * 1e3 / symbols, wire[1] / 1e6, mismatches[1], decodeMismatch);
+  printf("  protobuf end-to-end speedup %.1fx\n", fetchSec[0] / fetchSec[1]);
+}
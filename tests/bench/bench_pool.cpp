@@ -0,0 +1,53 @@
+#include "bench.h"
+#include "fetch_pool.h"
+#include "local_server.h"
+#include <chrono>
+#include <future>
+#include <string>
+#include <vector>
+
+using namespace std::chrono;
+
+// ---- user-008: pool worker vs satu thread fetch, backend dengan latency tetap
+static bool PoolRunner(FetchTask& task) {
+  std::string body;
+  return PlainGet(bench::Server().url() + "/api/amibroker/financials?symbol=" + task.symbol, body) == 200 && !body.empty();
+}
+
+BENCH("user-008", "throughput FetchPool vs jumlah worker (stand-in server, latency 20 ms)") {
+  const int tasks = bench::Quick() ? 8 : 64;
+  const int latencyMs = 20;
+  bench::Server().setHandler([&](const ServedRequest&) {
+    ServedResponse r;
+    r.body = "{\"data\":[{\"metric\":1}]}";
+    r.delayMs = latencyMs;
+    return r;
+  });
+
+  printf("  %d tasks per run, server latency %d ms/request\n", tasks, latencyMs);
+  double single = 0;
+  for (int workers : { 1, 2, 4, 8 }) {
+    FetchPoolConfig cfg;
+    cfg.workers = workers;
+    for (int& limit : cfg.endpointLimit) limit = workers;
+    FetchPool::instance().start(cfg, &PoolRunner);
+
+    auto t0 = steady_clock::now();
+    std::vector<std::shared_future<bool>> futures(tasks);
+    for (int i = 0; i < tasks; i++) {
+      FetchTask task;
+      task.type = FetchTaskType::GET_FINANCIALS;
+      task.symbolId = static_cast<SymbolId>(workers * 1000 + i);
+      task.symbol = "S" + std::to_string(task.symbolId);
+      FetchPool::instance().submit(MakeTaskKey(task.type, task.symbolId, kNoSymbol), task, &futures[i]);
+    }
+    int ok = 0;
+    for (auto& f : futures) ok += f.get() ? 1 : 0;
+    double sec = duration<double>(steady_clock::now() - t0).count();
+    FetchPool::instance().stop();
+
+    if (workers == 1) single = tasks / sec;
+    printf("  %d worker(s): %6.1f tasks/s (%d/%d ok, %.2fx vs 1 worker, ideal %.0f/s)\n",
+           workers, tasks / sec, ok, tasks, (tasks / sec) / single, workers * 1000.0 / latencyMs);
+  }
+}
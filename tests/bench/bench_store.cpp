@@ -0,0 +1,136 @@
+#include "bench.h"
+#include "data_store.h"
+#include "fixtures.h"
+#include <atomic>
+#include <cstring>
+#include <map>
+#include <mutex>
+#include <thread>
+
+// ---- Baseline: DataStore lama (satu mutex, std::map per string, getHistorical
+// mengembalikan copy vector). Bar memakai Quotation supaya yang diukur hanya
+// pola locking & copy, bukan layout (itu user-001).
+class LegacyStore {
+public:
+  void setHistorical(const std::string& symbol, const std::vector<Quotation>& bars) {
+    std::lock_guard<std::mutex> lock(m_mtx);
+    m_historical[symbol] = bars;
+  }
+  std::vector<Quotation> getHistorical(const std::string& symbol) {
+    std::lock_guard<std::mutex> lock(m_mtx);
+    auto it = m_historical.find(symbol);
+    return it == m_historical.end() ? std::vector<Quotation>() : it->second;
+  }
+  void updateLiveQuote(const StockFeed& feed) {
+    std::lock_guard<std::mutex> lock(m_mtx);
+    LiveQuote& q = m_live[feed.stock_data.symbol];
+    q.symbol = feed.stock_data.symbol;
+    q.lastprice = feed.stock_data.close;
+    q.volume = feed.stock_data.volume;
+    q.timestamp = feed.stock_data.date;
+  }
+  LiveQuote getLiveQuote(const std::string& symbol) {
+    std::lock_guard<std::mutex> lock(m_mtx);
+    return m_live[symbol];
+  }
+
+private:
+  std::mutex m_mtx;
+  std::map<std::string, std::vector<Quotation>> m_historical;
+  std::map<std::string, LiveQuote> m_live;
+};
+
+struct ContentionResult {
+  double readsPerSec;
+  double writesPerSec;
+  double worstReadUs;
+};
+
+// Satu writer WS (updateLiveQuote, dipacing ke targetRate) + N reader yang
+// meniru GetQuotesEx: ambil seri historis + live quote lalu baca bar terakhir.
+template <class Read, class Write>
+static ContentionResult RunContention(int readers, double targetRate, int durationMs, Read read, Write write) {
+  std::atomic<bool> stop{false};
+  std::atomic<long long> reads{0};
+  std::atomic<long long> writes{0};
+  std::atomic<long long> worstNs{0};
+
+  std::thread writer([&] {
+    StockFeed feed;
+    memset(&feed, 0, sizeof(feed));
+    feed.has_stock_data = true;
+    strcpy(feed.stock_data.symbol, "BBCA");
+    strcpy(feed.stock_data.date, "2024-06-12 10:00:00");
+    const auto interval = std::chrono::nanoseconds(static_cast<long long>(1e9 / targetRate));
+    auto next = std::chrono::steady_clock::now();
+    while (!stop.load(std::memory_order_relaxed)) {
+      feed.stock_data.close = 9000 + (writes % 50);
+      feed.stock_data.volume += 100;
+      write(feed);
+      writes++;
+      next += interval;
+      std::this_thread::sleep_until(next);
+    }
+  });
+
+  std::vector<std::thread> threads;
+  for (int r = 0; r < readers; r++) {
+    threads.emplace_back([&] {
+      long long local = 0;
+      long long worst = 0;
+      while (!stop.load(std::memory_order_relaxed)) {
+        auto t0 = std::chrono::steady_clock::now();
+        read();
+        long long ns = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - t0).count();
+        worst = std::max(worst, ns);
+        local++;
+      }
+      reads += local;
+      long long prev = worstNs.load();
+      while (worst > prev && !worstNs.compare_exchange_weak(prev, worst)) {}
+    });
+  }
+
+  std::this_thread::sleep_for(std::chrono::milliseconds(durationMs));
+  stop = true;
+  writer.join();
+  for (auto& t : threads) t.join();
+  const double sec = durationMs / 1000.0;
+  return { reads / sec, writes / sec, worstNs / 1000.0 };
+}
+
+BENCH("user-002", "kontensi DataStore: writer WS 20k update/s + N reader GetQuotesEx") {
+  const size_t n = 5000;
+  const int durationMs = bench::Quick() ? 100 : 1000;
+  auto bars = ToQuotations(MakeSourceBars(DayOf(2005, 1, 3), n));
+
+  static DataStore store;     // Slot array besar: jangan di stack
+  const SymbolId id = SymbolTable::instance().intern("BBCA");
+  store.setHistorical(id, bars);
+  LegacyStore legacy;
+  legacy.setHistorical("BBCA", bars);
+
+  printf("  %zu bars/symbol, %d ms per run; reads = getHistorical + getLiveQuote + last bar\n", n, durationMs);
+  for (int readers : { 1, 2, 4 }) {
+    ContentionResult oldR = RunContention(readers, 20000.0, durationMs,
+      [&] {
+        auto series = legacy.getHistorical("BBCA");
+        auto live = legacy.getLiveQuote("BBCA");
+        bench::Keep(series.back().Price + live.lastprice);
+      },
+      [&](const StockFeed& feed) { legacy.updateLiveQuote(feed); });
+
+    ContentionResult newR = RunContention(readers, 20000.0, durationMs,
+      [&] {
+        auto series = store.getHistorical(id);
+        auto live = store.getLiveQuote(id);
+        bench::Keep(series->bars.back().Price + (live ? live->lastprice : 0.0));
+      },
+      [&](const StockFeed& feed) { store.updateLiveQuote(feed); });
+
+    printf("  %d reader(s): old mutex+copy %9.0f reads/s (writer %6.0f/s, worst read %7.0f us) | "
+           "new RCU %10.0f reads/s (writer %6.0f/s, worst read %5.0f us) -> %.2fx reads\n",
+           readers, oldR.readsPerSec, oldR.writesPerSec, oldR.worstReadUs,
+           newR.readsPerSec, newR.writesPerSec, newR.worstReadUs, newR.readsPerSec / oldR.readsPerSec);
+  }
+}
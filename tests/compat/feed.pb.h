@@ -0,0 +1,25 @@
+#ifndef TESTS_COMPAT_FEED_PB_H
+#define TESTS_COMPAT_FEED_PB_H
+
+// ---- Pengganti feed.pb.h (hasil generate nanopb dari proto backend, tidak ada
+// di repo) untuk build test/bench. Cuma field StockFeed yang dibaca DataStore.
+struct StockChange {
+  double value;
+  double percentage;
+};
+
+struct StockData {
+  char symbol[16];
+  double close, previous, open, high, low, volume, value, frequency;
+  char date[32];
+  double foreignbuy, foreignsell;
+  bool has_change;
+  StockChange change;
+};
+
+struct StockFeed {
+  bool has_stock_data;
+  StockData stock_data;
+};
+
+#endif // TESTS_COMPAT_FEED_PB_H
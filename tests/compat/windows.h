@@ -0,0 +1,72 @@
+#ifndef TESTS_COMPAT_WINDOWS_H
+#define TESTS_COMPAT_WINDOWS_H
+
+// ---- Pengganti <windows.h> untuk build test/bench di luar Windows.
+// Hanya subset yang dipakai unit portable: tipe di plugin.h, fungsi CRT *_s
+// dan helper log (GetLocalTime + OutputDebugStringA). Log ke stderr kalau
+// VALKYRIE_TEST_LOG diset, selain itu dibuang.
+#ifdef _WIN32
+#error "tests/compat/windows.h hanya untuk build non-Windows"
+#endif
+
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <ctime>
+
+typedef void* HWND;
+typedef void* HANDLE;
+typedef const char* LPCTSTR;
+typedef int BOOL;
+typedef unsigned long DWORD;
+typedef unsigned long COLORREF;
+typedef unsigned int UINT;
+typedef uintptr_t WPARAM;
+typedef intptr_t LPARAM;
+
+#ifndef TRUE
+#define TRUE 1
+#define FALSE 0
+#endif
+#define WM_USER 0x0400
+#define __int64 long long
+#define __declspec(x)
+
+struct SYSTEMTIME {
+  unsigned short wYear, wMonth, wDayOfWeek, wDay, wHour, wMinute, wSecond, wMilliseconds;
+};
+
+inline void GetLocalTime(SYSTEMTIME* st) {
+  auto now = std::chrono::system_clock::now();
+  std::time_t t = std::chrono::system_clock::to_time_t(now);
+  std::tm tm;
+  localtime_r(&t, &tm);
+  st->wYear = static_cast<unsigned short>(tm.tm_year + 1900);
+  st->wMonth = static_cast<unsigned short>(tm.tm_mon + 1);
+  st->wDayOfWeek = static_cast<unsigned short>(tm.tm_wday);
+  st->wDay = static_cast<unsigned short>(tm.tm_mday);
+  st->wHour = static_cast<unsigned short>(tm.tm_hour);
+  st->wMinute = static_cast<unsigned short>(tm.tm_min);
+  st->wSecond = static_cast<unsigned short>(tm.tm_sec);
+  st->wMilliseconds = static_cast<unsigned short>(
+      std::chrono::duration_cast<std::chrono::milliseconds>(now.time_since_epoch()).count() % 1000);
+}
+
+inline void OutputDebugStringA(const char* msg) {
+  if (std::getenv("VALKYRIE_TEST_LOG")) std::fputs(msg, stderr);
+}
+
+template <size_t N, class... Args>
+int sprintf_s(char (&buf)[N], const char* fmt, Args... args) {
+  return std::snprintf(buf, N, fmt, args...);
+}
+
+// Cuma dipakai dengan %d, jadi tidak ada argumen ukuran buffer yang perlu diterjemahkan
+#define sscanf_s sscanf
+
+inline int localtime_s(std::tm* out, const std::time_t* t) {
+  return localtime_r(t, out) ? 0 : 1;
+}
+
+#endif // TESTS_COMPAT_WINDOWS_H
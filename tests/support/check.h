@@ -0,0 +1,53 @@
+#ifndef TESTS_CHECK_H
+#define TESTS_CHECK_H
+
+// ---- Harness test minimal (tanpa dependency): TEST_CASE mendaftar fungsi,
+// CHECK mencatat kegagalan tanpa menghentikan test, REQUIRE menghentikan test.
+#include <cstdio>
+#include <vector>
+
+namespace check {
+
+struct TestCase {
+  const char* name;
+  void (*fn)();
+};
+
+inline std::vector<TestCase>& registry() {
+  static std::vector<TestCase> tests;
+  return tests;
+}
+
+inline int& failures() {
+  static int count = 0;
+  return count;
+}
+
+struct Registrar {
+  Registrar(const char* name, void (*fn)()) { registry().push_back({ name, fn }); }
+};
+
+struct RequireFailed {};
+
+inline bool report(bool ok, const char* expr, const char* file, int line) {
+  if (!ok) {
+    std::fprintf(stderr, "  %s:%d: CHECK(%s) failed\n", file, line, expr);
+    failures()++;
+  }
+  return ok;
+}
+
+} // namespace check
+
+#define CHECK_CONCAT_(a, b) a##b
+#define CHECK_CONCAT(a, b) CHECK_CONCAT_(a, b)
+
+#define TEST_CASE(name)                                                              \
+  static void CHECK_CONCAT(test_fn_, __LINE__)();                                    \
+  static check::Registrar CHECK_CONCAT(test_reg_, __LINE__)(name, &CHECK_CONCAT(test_fn_, __LINE__)); \
+  static void CHECK_CONCAT(test_fn_, __LINE__)()
+
+#define CHECK(expr) check::report(static_cast<bool>(expr), #expr, __FILE__, __LINE__)
+#define REQUIRE(expr) do { if (!CHECK(expr)) throw check::RequireFailed(); } while (0)
+
+#endif // TESTS_CHECK_H
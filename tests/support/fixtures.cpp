@@ -0,0 +1,218 @@
+#include "fixtures.h"
+#include "pb_encode.h"
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+#include <zlib.h>
+
+// ---- Kalender proleptik Gregorian (algoritma days_from_civil Howard Hinnant)
+int32_t DayOf(int year, int month, int day) {
+  year -= month <= 2;
+  const int era = (year >= 0 ? year : year - 399) / 400;
+  const int yoe = year - era * 400;
+  const int doy = (153 * (month + (month > 2 ? -3 : 9)) + 2) / 5 + day - 1;
+  const int doe = yoe * 365 + yoe / 4 - yoe / 100 + doy;
+  return era * 146097 + doe - 719468;
+}
+
+static void CivilOf(int32_t z, int& year, int& month, int& day) {
+  z += 719468;
+  const int era = (z >= 0 ? z : z - 146096) / 146097;
+  const int doe = z - era * 146097;
+  const int yoe = (doe - doe / 1460 + doe / 36524 - doe / 146096) / 365;
+  const int doy = doe - (365 * yoe + yoe / 4 - yoe / 100);
+  const int mp = (5 * doy + 2) / 153;
+  day = doy - (153 * mp + 2) / 5 + 1;
+  month = mp < 10 ? mp + 3 : mp - 9;
+  year = yoe + era * 400 + (month <= 2);
+}
+
+bool IsWeekdayDay(int32_t day) {
+  int weekday = (day + 4) % 7;     // 1970-01-01 = Kamis, 0 = Minggu
+  if (weekday < 0) weekday += 7;
+  return weekday != 0 && weekday != 6;
+}
+
+std::string IsoDate(int32_t day) {
+  int y, m, d;
+  CivilOf(day, y, m, d);
+  char buf[16];
+  snprintf(buf, sizeof(buf), "%04d-%02d-%02d", y, m, d);
+  return buf;
+}
+
+DATE_TIME_INT EodDateOf(int32_t day) {
+  int y, m, d;
+  CivilOf(day, y, m, d);
+  AmiDate a;
+  a.Date = 0;
+  a.PackDate.Year = y;
+  a.PackDate.Month = m;
+  a.PackDate.Day = d;
+  a.PackDate.Hour = DATE_EOD_HOURS;
+  a.PackDate.Minute = DATE_EOD_MINUTES;
+  return a.Date;
+}
+
+std::vector<SourceBar> MakeSourceBars(int32_t firstDay, size_t n, uint32_t seed) {
+  std::vector<SourceBar> bars;
+  bars.reserve(n);
+  uint32_t state = seed * 2654435761u + 1;
+  auto next = [&](uint32_t mod) {
+    state = state * 1664525u + 1013904223u;
+    return static_cast<int64_t>((state >> 8) % mod);
+  };
+
+  int64_t close = 1000 + next(9000);
+  for (int32_t day = firstDay; bars.size() < n; day++) {
+    if (!IsWeekdayDay(day)) continue;
+    SourceBar b;
+    b.day = day;
+    close = std::max<int64_t>(50, close + next(41) - 20);
+    b.close = close;
+    b.open = close + next(11) - 5;
+    b.high = std::max(b.open, b.close) + next(10);
+    b.low = std::min(b.open, b.close) - next(10);
+    b.volume = 100 + next(5000000);
+    b.frequency = 1 + next(20000);
+    b.value = b.volume * close;
+    b.foreignBuy = next(1000000);
+    b.foreignSell = next(1000000);
+    bars.push_back(b);
+  }
+  return bars;
+}
+
+Quotation ToQuotation(const SourceBar& b) {
+  Quotation q;
+  memset(&q, 0, sizeof(q));
+  q.DateTime.Date = EodDateOf(b.day);
+  q.Price = static_cast<float>(b.close);
+  q.Open = static_cast<float>(b.open);
+  q.High = static_cast<float>(b.high);
+  q.Low = static_cast<float>(b.low);
+  q.Volume = static_cast<float>(b.volume);
+  q.OpenInterest = static_cast<float>(b.frequency);
+  q.AuxData1 = static_cast<float>(b.value);
+  q.AuxData2 = static_cast<float>(b.foreignBuy) - static_cast<float>(b.foreignSell);
+  return q;
+}
+
+std::vector<Quotation> ToQuotations(const std::vector<SourceBar>& bars) {
+  std::vector<Quotation> out;
+  out.reserve(bars.size());
+  for (const SourceBar& b : bars) out.push_back(ToQuotation(b));
+  return out;
+}
+
+Quotation MakeBar(int32_t day, float close) {
+  Quotation q;
+  memset(&q, 0, sizeof(q));
+  q.DateTime.Date = EodDateOf(day);
+  q.Price = close;
+  q.Open = close;
+  q.High = close + 1;
+  q.Low = close - 1;
+  q.Volume = 100;
+  return q;
+}
+
+std::string ChartbitJson(const std::vector<SourceBar>& bars) {
+  std::string out = "{\"status\":\"ok\",\"chartbit\":[";
+  char rec[512];
+  for (size_t i = 0; i < bars.size(); i++) {
+    const SourceBar& b = bars[i];
+    snprintf(rec, sizeof(rec),
+             "%s{\"date\":\"%s\",\"open\":%lld,\"high\":%lld,\"low\":%lld,\"close\":%lld,"
+             "\"volume\":%lld,\"frequency\":%lld,\"value\":%lld,\"foreignbuy\":%lld,\"foreignsell\":%lld}",
+             i ? "," : "", IsoDate(b.day).c_str(), (long long)b.open, (long long)b.high, (long long)b.low,
+             (long long)b.close, (long long)b.volume, (long long)b.frequency, (long long)b.value,
+             (long long)b.foreignBuy, (long long)b.foreignSell);
+    out += rec;
+  }
+  out += "]}";
+  return out;
+}
+
+// ---- Encoder HistoricalBars pakai primitive nanopb (pb_encode_*), ke std::string
+static bool WriteString(pb_ostream_t* stream, const pb_byte_t* buf, size_t count) {
+  static_cast<std::string*>(stream->state)->append(reinterpret_cast<const char*>(buf), count);
+  return true;
+}
+
+static void EncodeColumn(pb_ostream_t* stream, uint32_t field, const std::vector<int64_t>& col, bool isSigned, bool packed) {
+  auto encodeValue = [&](pb_ostream_t* s, int64_t v) {
+    return isSigned ? pb_encode_svarint(s, v) : pb_encode_varint(s, static_cast<uint64_t>(v));
+  };
+  if (!packed) {
+    for (int64_t v : col) {
+      pb_encode_tag(stream, PB_WT_VARINT, field);
+      encodeValue(stream, v);
+    }
+    return;
+  }
+  pb_ostream_t sizing = PB_OSTREAM_SIZING;
+  for (int64_t v : col) encodeValue(&sizing, v);
+  pb_encode_tag(stream, PB_WT_STRING, field);
+  pb_encode_varint(stream, static_cast<uint64_t>(sizing.bytes_written));
+  for (int64_t v : col) encodeValue(stream, v);
+}
+
+std::string HistoricalProto(const std::vector<SourceBar>& bars, bool packed) {
+  std::string out;
+  pb_ostream_t stream = PB_OSTREAM_SIZING;
+  stream.callback = &WriteString;
+  stream.state = &out;
+  stream.max_size = SIZE_MAX;
+
+  std::vector<int64_t> dayDelta, close, open, high, low, volume, frequency, value, netForeign;
+  int32_t prevDay = bars.empty() ? 0 : bars[0].day;
+  int64_t prevClose = 0;
+  for (const SourceBar& b : bars) {
+    dayDelta.push_back(b.day - prevDay);
+    close.push_back(b.close - prevClose);
+    open.push_back(b.open - b.close);
+    high.push_back(b.high - b.close);
+    low.push_back(b.low - b.close);
+    volume.push_back(b.volume);
+    frequency.push_back(b.frequency);
+    value.push_back(b.value);
+    netForeign.push_back(b.foreignBuy - b.foreignSell);
+    prevDay = b.day;
+    prevClose = b.close;
+  }
+
+  pb_encode_tag(&stream, PB_WT_VARINT, 1);
+  pb_encode_svarint(&stream, static_cast<int64_t>(bars.empty() ? 0 : bars[0].day));
+  EncodeColumn(&stream, 2, dayDelta, false, packed);
+  EncodeColumn(&stream, 4, close, true, packed);
+  EncodeColumn(&stream, 5, open, true, packed);
+  EncodeColumn(&stream, 6, high, true, packed);
+  EncodeColumn(&stream, 7, low, true, packed);
+  EncodeColumn(&stream, 8, volume, false, packed);
+  EncodeColumn(&stream, 9, frequency, false, packed);
+  EncodeColumn(&stream, 10, value, false, packed);
+  EncodeColumn(&stream, 11, netForeign, true, packed);
+  return out;
+}
+
+std::string Compress(const std::string& data, const std::string& encoding) {
+  int windowBits = encoding == "gzip" ? 15 + 16 : encoding == "raw-deflate" ? -15 : 15;
+  z_stream zs;
+  memset(&zs, 0, sizeof(zs));
+  deflateInit2(&zs, Z_DEFAULT_COMPRESSION, Z_DEFLATED, windowBits, 8, Z_DEFAULT_STRATEGY);
+
+  std::string out(deflateBound(&zs, static_cast<uLong>(data.size())), '\0');
+  zs.next_in = reinterpret_cast<Bytef*>(const_cast<char*>(data.data()));
+  zs.avail_in = static_cast<uInt>(data.size());
+  zs.next_out = reinterpret_cast<Bytef*>(&out[0]);
+  zs.avail_out = static_cast<uInt>(out.size());
+  deflate(&zs, Z_FINISH);
+  out.resize(zs.total_out);
+  deflateEnd(&zs);
+  return out;
+}
+
+bool SameBars(const std::vector<Quotation>& a, const std::vector<Quotation>& b) {
+  return a.size() == b.size() && (a.empty() || memcmp(a.data(), b.data(), a.size() * sizeof(Quotation)) == 0);
+}
@@ -0,0 +1,48 @@
+#ifndef TESTS_FIXTURES_H
+#define TESTS_FIXTURES_H
+
+// ---- Data uji: seri bar sintetis dalam satuan backend, konversi ke baris
+// Quotation, dan encoder format wire backend (JSON chartbit, HistoricalBars
+// protobuf - lihat historical_proto.h - dan body compressed).
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+#include "plugin.h"
+
+// Kalender data uji, sengaja tidak memakai helper tanggal plugin (yang sedang diuji).
+// Hari = epoch day (hari sejak 1970-01-01).
+int32_t DayOf(int year, int month, int day);
+bool IsWeekdayDay(int32_t day);
+std::string IsoDate(int32_t day);               // "YYYY-MM-DD"
+DATE_TIME_INT EodDateOf(int32_t day);           // Packed date EOD AmiBroker
+
+// Satu bar dalam satuan integer seperti di backend (harga rupiah utuh)
+struct SourceBar {
+  int32_t day;                  // Epoch day
+  int64_t open, high, low, close;
+  int64_t volume, frequency, value;
+  int64_t foreignBuy, foreignSell;
+};
+
+// n bar hari kerja berurutan mulai firstDay (akhir pekan dilewati). Deterministik per seed.
+std::vector<SourceBar> MakeSourceBars(int32_t firstDay, size_t n, uint32_t seed = 1);
+
+Quotation ToQuotation(const SourceBar& bar);
+std::vector<Quotation> ToQuotations(const std::vector<SourceBar>& bars);
+
+// Bar minimal: tanggal + close (field lain diturunkan dari close)
+Quotation MakeBar(int32_t day, float close);
+
+// Body JSON endpoint historical: {"status":"ok","chartbit":[{...}, ...]}
+std::string ChartbitJson(const std::vector<SourceBar>& bars);
+
+// Body HistoricalBars. packed = false: satu tag per nilai (encoder lama).
+std::string HistoricalProto(const std::vector<SourceBar>& bars, bool packed = true);
+
+// encoding: "gzip", "deflate" (zlib) atau "raw-deflate"
+std::string Compress(const std::string& data, const std::string& encoding);
+
+bool SameBars(const std::vector<Quotation>& a, const std::vector<Quotation>& b);
+
+#endif // TESTS_FIXTURES_H
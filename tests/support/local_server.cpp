@@ -0,0 +1,225 @@
+#include "local_server.h"
+#include "fixtures.h"     // Compress
+#include <algorithm>
+#include <cctype>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <poll.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+LocalServer::LocalServer(Handler handler) : m_handler(std::move(handler)) {
+  m_listenFd = ::socket(AF_INET, SOCK_STREAM, 0);
+  int one = 1;
+  setsockopt(m_listenFd, SOL_SOCKET, SO_REUSEADDR, &one, sizeof(one));
+
+  sockaddr_in addr;
+  memset(&addr, 0, sizeof(addr));
+  addr.sin_family = AF_INET;
+  addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+  addr.sin_port = 0;
+  ::bind(m_listenFd, reinterpret_cast<sockaddr*>(&addr), sizeof(addr));
+  ::listen(m_listenFd, 128);
+
+  socklen_t len = sizeof(addr);
+  getsockname(m_listenFd, reinterpret_cast<sockaddr*>(&addr), &len);
+  m_port = ntohs(addr.sin_port);
+  m_acceptThread = std::thread(&LocalServer::acceptLoop, this);
+}
+
+LocalServer::~LocalServer() {
+  m_stop = true;
+  m_acceptThread.join();
+  ::close(m_listenFd);
+
+  // Thread koneksi cek m_stop tiap 50 ms
+  while (m_active > 0) std::this_thread::sleep_for(std::chrono::milliseconds(5));
+}
+
+std::string LocalServer::url() const {
+  return "http://127.0.0.1:" + std::to_string(m_port);
+}
+
+void LocalServer::setHandler(Handler handler) {
+  std::lock_guard<std::mutex> lock(m_mtx);
+  m_handler = std::move(handler);
+}
+
+void LocalServer::resetCounters() {
+  m_connections = 0;
+  m_requests = 0;
+}
+
+ServedResponse LocalServer::handle(const ServedRequest& req) {
+  Handler handler;
+  {
+    std::lock_guard<std::mutex> lock(m_mtx);
+    handler = m_handler;
+  }
+  return handler(req);
+}
+
+void LocalServer::acceptLoop() {
+  while (!m_stop) {
+    pollfd pfd{ m_listenFd, POLLIN, 0 };
+    if (::poll(&pfd, 1, 50) <= 0) continue;
+    int fd = ::accept(m_listenFd, nullptr, nullptr);
+    if (fd < 0) continue;
+    m_connections++;
+    m_active++;
+    std::thread(&LocalServer::serve, this, fd).detach();
+  }
+}
+
+static bool SendAll(int fd, const char* data, size_t n) {
+  while (n > 0) {
+    ssize_t sent = ::send(fd, data, n, MSG_NOSIGNAL);
+    if (sent <= 0) return false;
+    data += sent;
+    n -= static_cast<size_t>(sent);
+  }
+  return true;
+}
+
+static std::string HeaderValue(const std::string& head, const char* name) {
+  std::string lower = head;
+  std::transform(lower.begin(), lower.end(), lower.begin(), [](unsigned char c) { return (char)std::tolower(c); });
+  std::string key = std::string("\r\n") + name + ":";
+  size_t pos = lower.find(key);
+  if (pos == std::string::npos) return std::string();
+  size_t begin = head.find_first_not_of(' ', pos + key.size());
+  return head.substr(begin, head.find("\r\n", begin) - begin);
+}
+
+void LocalServer::serve(int fd) {
+  std::string buf;
+  char chunk[16384];
+  while (!m_stop) {
+    // ---- Tunggu satu request utuh (GET tanpa body); idle dicek berkala supaya bisa stop
+    size_t headEnd;
+    bool closed = false;
+    while ((headEnd = buf.find("\r\n\r\n")) == std::string::npos) {
+      pollfd pfd{ fd, POLLIN, 0 };
+      if (m_stop) { closed = true; break; }
+      if (::poll(&pfd, 1, 50) <= 0) continue;
+      ssize_t n = ::recv(fd, chunk, sizeof(chunk), 0);
+      if (n <= 0) { closed = true; break; }
+      buf.append(chunk, static_cast<size_t>(n));
+    }
+    if (closed) break;
+
+    std::string head = buf.substr(0, headEnd);
+    buf.erase(0, headEnd + 4);
+    ServedRequest req;
+    size_t pathBegin = head.find(' ') + 1;
+    req.path = head.substr(pathBegin, head.find(' ', pathBegin) - pathBegin);
+    req.accept = HeaderValue(head, "accept");
+    req.acceptEncoding = HeaderValue(head, "accept-encoding");
+    m_requests++;
+
+    ServedResponse res = handle(req);
+    if (res.delayMs > 0) std::this_thread::sleep_for(std::chrono::milliseconds(res.delayMs));
+
+    std::string wire = res.body;
+    std::string encodingHeader = res.encoding == "raw-deflate" ? "deflate" : res.encoding;
+    if (!res.encoding.empty() && !res.bodyEncoded) wire = Compress(res.body, res.encoding);
+    if (res.wireLimit > 0 && res.wireLimit < wire.size()) wire.resize(res.wireLimit);
+
+    char status[64];
+    snprintf(status, sizeof(status), "HTTP/1.1 %d X\r\n", res.status);
+    std::string out = status;
+    out += "Content-Type: " + res.contentType + "\r\n";
+    if (!encodingHeader.empty()) out += "Content-Encoding: " + encodingHeader + "\r\n";
+    if (res.retryAfterSec) out += "Retry-After: " + std::to_string(res.retryAfterSec) + "\r\n";
+    const bool close = res.closeAfter || res.noLength || res.dropMidBody;
+    if (close) out += "Connection: close\r\n";
+    if (res.chunked) out += "Transfer-Encoding: chunked\r\n";
+    else if (!res.noLength) out += "Content-Length: " + std::to_string(wire.size()) + "\r\n";
+    out += "\r\n";
+    const size_t headerLen = out.size();
+
+    if (res.chunked) {
+      // Chunk kecil & tidak rata supaya batas chunk jatuh di tengah record / header gzip
+      for (size_t pos = 0, step = 7; pos < wire.size(); pos += step, step = step * 2 + 3) {
+        size_t n = std::min(step, wire.size() - pos);
+        char size[32];
+        snprintf(size, sizeof(size), "%zx\r\n", n);
+        out += size;
+        out.append(wire, pos, n);
+        out += "\r\n";
+      }
+      out += "0\r\n";
+      if (res.trailers.empty()) out += "\r\n";
+    } else {
+      out += wire;
+    }
+    if (res.dropMidBody) out.resize(headerLen + (out.size() - headerLen) / 2);
+
+    if (!SendAll(fd, out.data(), out.size())) break;
+
+    // Trailer dikirim per baris dengan jeda: client harus membaca sampai baris kosong
+    if (res.chunked && !res.trailers.empty()) {
+      std::string tail = res.trailers + "\r\n";
+      bool ok = true;
+      for (size_t pos = 0; ok && pos < tail.size();) {
+        size_t next = tail.find("\r\n", pos) + 2;
+        std::this_thread::sleep_for(std::chrono::milliseconds(2));
+        ok = SendAll(fd, tail.data() + pos, next - pos);
+        pos = next;
+      }
+      if (!ok) break;
+    }
+    if (close || res.closeSilently) break;
+  }
+  ::close(fd);
+  m_active--;
+}
+
+int PlainGet(const std::string& url, std::string& body) {
+  body.clear();
+  const size_t hostBegin = url.find("://") + 3;
+  const size_t pathBegin = url.find('/', hostBegin);
+  const size_t colon = url.find(':', hostBegin);
+  const int port = std::atoi(url.c_str() + colon + 1);
+
+  int fd = ::socket(AF_INET, SOCK_STREAM, 0);
+  sockaddr_in addr;
+  memset(&addr, 0, sizeof(addr));
+  addr.sin_family = AF_INET;
+  addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+  addr.sin_port = htons(static_cast<uint16_t>(port));
+  if (::connect(fd, reinterpret_cast<sockaddr*>(&addr), sizeof(addr)) != 0) {
+    ::close(fd);
+    return 0;
+  }
+
+  const std::string request = "GET " + url.substr(pathBegin) + " HTTP/1.1\r\nHost: 127.0.0.1\r\n\r\n";
+  if (!SendAll(fd, request.data(), request.size())) {
+    ::close(fd);
+    return 0;
+  }
+
+  // Respons default selalu pakai Content-Length: baca header, lalu body sepanjang itu
+  std::string response;
+  char chunk[16384];
+  size_t headEnd = std::string::npos;
+  size_t total = 0;
+  while (headEnd == std::string::npos || response.size() < total) {
+    ssize_t n = ::recv(fd, chunk, sizeof(chunk), 0);
+    if (n <= 0) break;
+    response.append(chunk, static_cast<size_t>(n));
+    if (headEnd == std::string::npos && (headEnd = response.find("\r\n\r\n")) != std::string::npos) {
+      const size_t length = response.find("Content-Length: ");
+      total = headEnd + 4 + (length < headEnd ? std::strtoul(response.c_str() + length + 16, nullptr, 10) : 0);
+    }
+  }
+  ::close(fd);
+
+  if (headEnd == std::string::npos || response.size() < total || response.compare(0, 9, "HTTP/1.1 ") != 0) return 0;
+  body = response.substr(headEnd + 4);
+  return std::atoi(response.c_str() + 9);
+}
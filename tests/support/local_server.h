@@ -0,0 +1,76 @@
+#ifndef TESTS_LOCAL_SERVER_H
+#define TESTS_LOCAL_SERVER_H
+
+// ---- Stand-in server HTTP/1.1 lokal (127.0.0.1, port ephemeral) untuk test
+// & bench fetch. Satu thread per koneksi, keep-alive didukung. Handler
+// menentukan respons per request, termasuk kegagalan yang disengaja
+// (5xx, Retry-After, framing chunked / tanpa Content-Length, body compressed,
+// koneksi putus di tengah body).
+#include <atomic>
+#include <functional>
+#include <mutex>
+#include <string>
+#include <thread>
+
+struct ServedRequest {
+  std::string path;
+  std::string accept;
+  std::string acceptEncoding;
+};
+
+struct ServedResponse {
+  int status = 200;
+  std::string contentType = "application/json";
+  std::string body;               // Body sebelum di-encode
+  std::string encoding;           // "", "gzip", "deflate" (zlib) atau "raw-deflate" (header "deflate")
+  bool bodyEncoded = false;       // body sudah di-compress (bench: server tidak ikut makan CPU)
+  bool chunked = false;
+  bool closeAfter = false;        // Kirim "Connection: close" lalu tutup socket
+  bool noLength = false;          // Tanpa Content-Length / chunked: body sampai socket ditutup
+  size_t wireLimit = 0;           // > 0: body wire dipotong sekian byte, Content-Length ikut potongan
+  bool dropMidBody = false;       // Content-Length penuh, tapi koneksi ditutup di tengah body
+  bool closeSilently = false;     // Respons utuh tanpa "Connection: close", lalu socket ditutup (keep-alive timeout)
+  std::string trailers;           // Chunked: baris trailer setelah chunk 0 ("Name: value\r\n" ...)
+  int delayMs = 0;                // Latency backend sebelum respons dikirim
+  unsigned retryAfterSec = 0;
+};
+
+class LocalServer {
+public:
+  using Handler = std::function<ServedResponse(const ServedRequest&)>;
+
+  explicit LocalServer(Handler handler);
+  ~LocalServer();
+
+  LocalServer(const LocalServer&) = delete;
+  LocalServer& operator=(const LocalServer&) = delete;
+
+  std::string url() const;        // "http://127.0.0.1:<port>"
+  void setHandler(Handler handler);
+
+  int connections() const { return m_connections.load(); }
+  int requests() const { return m_requests.load(); }
+  void resetCounters();
+
+private:
+  void acceptLoop();
+  void serve(int fd);
+  ServedResponse handle(const ServedRequest& req);
+
+  int m_listenFd = -1;
+  int m_port = 0;
+  std::atomic<bool> m_stop{false};
+  std::atomic<int> m_connections{0};
+  std::atomic<int> m_requests{0};
+  std::thread m_acceptThread;
+
+  std::mutex m_mtx;
+  Handler m_handler;
+  std::atomic<int> m_active{0};   // Thread koneksi (detached) yang masih jalan
+};
+
+// Klien minimal untuk bench yang tidak lewat transport plugin: koneksi baru per
+// request, url "http://127.0.0.1:<port>/path". Return status HTTP, 0 kalau gagal.
+int PlainGet(const std::string& url, std::string& body);
+
+#endif // TESTS_LOCAL_SERVER_H
@@ -0,0 +1,118 @@
+#include "check.h"
+#include "test_env.h"
+#include "bar_cache.h"
+#include "bar_file.h"
+#include "fixtures.h"
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+
+static std::string TempPath(const char* name) {
+  return (std::filesystem::path(TestTempDir()) / name).string();
+}
+
+static void Overwrite(const std::string& path, size_t offset, const void* data, size_t n) {
+  std::fstream f(path, std::ios::binary | std::ios::in | std::ios::out);
+  f.seekp(static_cast<std::streamoff>(offset));
+  f.write(static_cast<const char*>(data), static_cast<std::streamsize>(n));
+}
+
+TEST_CASE("bar_file: tulis lalu map, record identik byte per byte") {
+  const std::string path = TempPath("roundtrip.vbc");
+  auto bars = ToQuotations(MakeSourceBars(DayOf(2020, 1, 1), 1500));
+  REQUIRE(WriteBarFile(path, bars.data(), bars.size(), sizeof(Quotation), 1700000000));
+  CHECK(!std::filesystem::exists(path + ".tmp"));
+  CHECK(std::filesystem::file_size(path) == sizeof(BarFileHeader) + bars.size() * sizeof(Quotation));
+
+  BarFileView view;
+  REQUIRE(view.open(path, sizeof(Quotation)));
+  CHECK(view.count() == bars.size());
+  CHECK(view.header()->savedAt == 1700000000u);
+  CHECK(memcmp(view.records(), bars.data(), bars.size() * sizeof(Quotation)) == 0);
+
+  // Tulis ulang saat view lama masih ter-map: view lama tetap valid (rename atomik)
+  auto shorter = std::vector<Quotation>(bars.begin(), bars.begin() + 10);
+  REQUIRE(WriteBarFile(path, shorter.data(), shorter.size(), sizeof(Quotation), 1700000001));
+  CHECK(memcmp(view.records(), bars.data(), bars.size() * sizeof(Quotation)) == 0);
+  BarFileView fresh;
+  REQUIRE(fresh.open(path, sizeof(Quotation)));
+  CHECK(fresh.count() == 10);
+}
+
+TEST_CASE("bar_file: file kosong (0 record) valid") {
+  const std::string path = TempPath("empty.vbc");
+  REQUIRE(WriteBarFile(path, nullptr, 0, sizeof(Quotation), 1));
+  BarFileView view;
+  REQUIRE(view.open(path, sizeof(Quotation)));
+  CHECK(view.count() == 0);
+}
+
+TEST_CASE("bar_file: header rusak / recordSize beda / file terpotong ditolak") {
+  const std::string path = TempPath("bad.vbc");
+  auto bars = ToQuotations(MakeSourceBars(DayOf(2021, 1, 1), 20));
+  BarFileView view;
+
+  CHECK(!view.open(TempPath("missing.vbc"), sizeof(Quotation)));
+
+  REQUIRE(WriteBarFile(path, bars.data(), bars.size(), sizeof(Quotation), 1));
+  CHECK(!view.open(path, sizeof(Quotation) + 8));     // Layout record lain
+
+  uint32_t badMagic = 0xDEADBEEF;
+  Overwrite(path, offsetof(BarFileHeader, magic), &badMagic, sizeof(badMagic));
+  CHECK(!view.open(path, sizeof(Quotation)));
+
+  REQUIRE(WriteBarFile(path, bars.data(), bars.size(), sizeof(Quotation), 1));
+  uint32_t badVersion = BAR_FILE_VERSION + 1;
+  Overwrite(path, offsetof(BarFileHeader, version), &badVersion, sizeof(badVersion));
+  CHECK(!view.open(path, sizeof(Quotation)));
+
+  REQUIRE(WriteBarFile(path, bars.data(), bars.size(), sizeof(Quotation), 1));
+  uint64_t badCount = bars.size() + 1;
+  Overwrite(path, offsetof(BarFileHeader, count), &badCount, sizeof(badCount));
+  CHECK(!view.open(path, sizeof(Quotation)));
+
+  REQUIRE(WriteBarFile(path, bars.data(), bars.size(), sizeof(Quotation), 1));
+  std::filesystem::resize_file(path, std::filesystem::file_size(path) - 1);
+  CHECK(!view.open(path, sizeof(Quotation)));
+
+  std::filesystem::resize_file(path, sizeof(BarFileHeader) - 1);
+  CHECK(!view.open(path, sizeof(Quotation)));
+  CHECK(view.header() == nullptr && view.count() == 0);
+}
+
+TEST_CASE("bar_cache: save/load per simbol, nama file aman") {
+  BarCache::setDirectory(TempPath("cache"));
+  REQUIRE(BarCache::enabled());
+
+  auto bars = ToQuotations(MakeSourceBars(DayOf(2022, 6, 1), 300));
+  REQUIRE(BarCache::save("^JKSE", bars));
+  CHECK(std::filesystem::exists(TempPath("cache/%5EJKSE.vbc")));
+
+  std::vector<Quotation> loaded;
+  REQUIRE(BarCache::load("^JKSE", loaded));
+  CHECK(SameBars(loaded, bars));
+  CHECK(!BarCache::load("BBCA", loaded));
+
+  // Ticker yang dulu jatuh ke nama file sama: "^JKSE"/"_JKSE", "bbca"/"BBCA"
+  // (NTFS case-insensitive), "CON" (nama device Windows)
+  auto other = ToQuotations(MakeSourceBars(DayOf(2023, 1, 2), 50));
+  CHECK(!BarCache::load("_JKSE", loaded));
+  REQUIRE(BarCache::save("_JKSE", other));
+  REQUIRE(BarCache::save("BBCA", bars));
+  REQUIRE(BarCache::save("bbca", other));
+  REQUIRE(BarCache::save("CON", other));
+  CHECK(std::filesystem::exists(TempPath("cache/%5FJKSE.vbc")));
+  CHECK(std::filesystem::exists(TempPath("cache/%62%62%63%61.vbc")));
+  CHECK(std::filesystem::exists(TempPath("cache/%43ON.vbc")));
+  REQUIRE(BarCache::load("^JKSE", loaded));
+  CHECK(SameBars(loaded, bars));
+  REQUIRE(BarCache::load("BBCA", loaded));
+  CHECK(SameBars(loaded, bars));
+  REQUIRE(BarCache::load("bbca", loaded));
+  CHECK(SameBars(loaded, other));
+
+  BarCache::setDirectory("");
+  CHECK(!BarCache::enabled());
+  CHECK(!BarCache::load("^JKSE", loaded));
+  CHECK(!BarCache::save("^JKSE", bars));
+}
@@ -0,0 +1,128 @@
+#include "check.h"
+#include "bar_series.h"
+#include "fixtures.h"
+#include <algorithm>
+#include <map>
+#include <random>
+
+// ---- Referensi: rebuild lewat std::map (cara lama DataStore::mergeHistorical)
+static std::vector<Quotation> ReferenceMerge(const std::vector<Quotation>& base, const std::vector<Quotation>& delta, size_t cap = SIZE_MAX) {
+  std::map<DATE_TIME_INT, Quotation> merged;
+  for (const Quotation& q : base) merged[q.DateTime.Date] = q;
+  for (const Quotation& q : delta) merged[q.DateTime.Date] = q;
+  std::vector<Quotation> out;
+  for (const auto& entry : merged) out.push_back(entry.second);
+  if (out.size() > cap) out.erase(out.begin(), out.end() - cap);
+  return out;
+}
+
+// Seri acak: tanggal unik urut dari rentang [from, from + span), close unik per seri
+static std::vector<Quotation> RandomSeries(std::mt19937& rng, int32_t from, int32_t span, size_t n, float tag) {
+  std::vector<int32_t> days(span);
+  for (int32_t i = 0; i < span; i++) days[i] = from + i;
+  std::shuffle(days.begin(), days.end(), rng);
+  days.resize(std::min<size_t>(n, days.size()));
+  std::sort(days.begin(), days.end());
+  std::vector<Quotation> out;
+  for (int32_t d : days) out.push_back(MakeBar(d, tag + static_cast<float>(d % 1000)));
+  return out;
+}
+
+TEST_CASE("SpliceBars: delta di ekor menimpa tanggal sama & menambah bar baru") {
+  const int32_t d0 = DayOf(2024, 1, 1);
+  std::vector<Quotation> base, delta, out;
+  for (int i = 0; i < 5000; i++) base.push_back(MakeBar(d0 + i, 100.0f));
+  delta = { MakeBar(d0 + 4998, 200.0f), MakeBar(d0 + 4999, 201.0f), MakeBar(d0 + 5000, 202.0f) };
+
+  SpliceBars(base, delta, out);
+  CHECK(out.size() == 5001);
+  CHECK(out[4997].Price == 100.0f && out[4998].Price == 200.0f && out[5000].Price == 202.0f);
+  CHECK(SameBars(out, ReferenceMerge(base, delta)));
+
+  SpliceBars(base, {}, out);
+  CHECK(SameBars(out, base));
+  SpliceBars({}, delta, out);
+  CHECK(SameBars(out, delta));
+}
+
+TEST_CASE("SpliceBars: delta tidak urut / duplikat, hasil sama dengan rebuild std::map") {
+  std::mt19937 rng(7);
+  for (int iter = 0; iter < 300; iter++) {
+    auto base = RandomSeries(rng, 0, 400, rng() % 300, 0.0f);
+    auto delta = RandomSeries(rng, static_cast<int32_t>(rng() % 400), 200, rng() % 40, 5000.0f);
+    if (!delta.empty() && iter % 2) {
+      Quotation dup = delta.front();
+      dup.Price = 9999.0f;
+      delta.push_back(dup);       // Duplikat: terakhir menang
+      std::shuffle(delta.begin(), delta.end() - 1, rng);
+    }
+    std::vector<Quotation> out;
+    SpliceBars(base, delta, out);
+    auto expected = ReferenceMerge(base, delta);
+    if (!CHECK(SameBars(out, expected))) break;
+  }
+}
+
+TEST_CASE("MergeBarsInPlace: gabung ke buffer AmiBroker tanpa alokasi") {
+  const int32_t d0 = DayOf(2024, 1, 1);
+  std::vector<Quotation> buf(5003);
+  for (int i = 0; i < 5000; i++) buf[i] = MakeBar(d0 + i, 100.0f);
+  std::vector<Quotation> base(buf.begin(), buf.begin() + 5000);
+  std::vector<Quotation> delta = { MakeBar(d0 + 4998, 200.0f), MakeBar(d0 + 4999, 201.0f), MakeBar(d0 + 5000, 202.0f) };
+
+  int n = MergeBarsInPlace(buf.data(), 5000, 5003, delta.data(), delta.size());
+  CHECK(n == 5001);
+  CHECK(SameBars(std::vector<Quotation>(buf.begin(), buf.begin() + n), ReferenceMerge(base, delta)));
+
+  // Kapasitas pas-pasan: bar paling lama yang dibuang
+  for (int i = 0; i < 5000; i++) buf[i] = base[i];
+  n = MergeBarsInPlace(buf.data(), 5000, 5000, delta.data(), delta.size());
+  CHECK(n == 5000);
+  CHECK(SameBars(std::vector<Quotation>(buf.begin(), buf.begin() + n), ReferenceMerge(base, delta, 5000)));
+
+  CHECK(MergeBarsInPlace(buf.data(), 10, 20, delta.data(), 0) == 10);
+  CHECK(MergeBarsInPlace(buf.data(), 0, 2, delta.data(), delta.size()) == 2);
+  CHECK(buf[0].Price == 201.0f && buf[1].Price == 202.0f);
+}
+
+TEST_CASE("MergeBarsInPlace: acak (lubang, overlap, cap kecil) sama dengan referensi") {
+  std::mt19937 rng(11);
+  for (int iter = 0; iter < 2000; iter++) {
+    auto base = RandomSeries(rng, 0, 300, rng() % 200, 0.0f);
+    auto delta = RandomSeries(rng, static_cast<int32_t>(rng() % 300) - 50, 150, rng() % 60, 5000.0f);
+    const int cap = std::max<int>(static_cast<int>(base.size()), 1 + static_cast<int>(rng() % 260));
+
+    std::vector<Quotation> buf(cap);
+    std::copy(base.begin(), base.end(), buf.begin());
+    int n = MergeBarsInPlace(buf.data(), static_cast<int>(base.size()), cap, delta.data(), delta.size());
+    auto expected = delta.empty() ? base : ReferenceMerge(base, delta, static_cast<size_t>(cap));
+    if (!CHECK(SameBars(std::vector<Quotation>(buf.begin(), buf.begin() + n), expected))) break;
+  }
+}
+
+TEST_CASE("BuildLiveBar: overlay bar hari ini vs bar baru") {
+  const int32_t today = DayOf(2024, 5, 6);
+  LiveQuote live;
+  live.open = 100;
+  live.high = 120;
+  live.low = 90;
+  live.lastprice = 110;
+  live.volume = 5000;
+
+  Quotation stored = MakeBar(today, 105.0f);
+  stored.High = 130.0f;
+  Quotation overlay = BuildLiveBar(&stored, live, EodDateOf(today));
+  CHECK(overlay.Price == 110.0f && overlay.High == 130.0f && overlay.Low == 90.0f && overlay.Open == 105.0f);
+  CHECK(overlay.Volume == 5000.0f);
+
+  Quotation yesterday = MakeBar(today - 1, 105.0f);
+  Quotation fresh = BuildLiveBar(&yesterday, live, EodDateOf(today));
+  CHECK(NormalizeEodDate(fresh.DateTime.Date) == EodDateOf(today));
+  CHECK(fresh.Open == 100.0f && fresh.High == 120.0f && fresh.Price == 110.0f);
+
+  // Bar overlay ditandai, tanda hilang setelah dinormalisasi; bar store tidak bertanda
+  CHECK(IsLiveBar(overlay) && IsLiveBar(fresh) && !IsLiveBar(stored));
+  Quotation normalized = fresh;
+  normalized.DateTime.Date = NormalizeEodDate(fresh.DateTime.Date);
+  CHECK(!IsLiveBar(normalized) && EodDateToDays(fresh.DateTime.Date) == today);
+}
@@ -0,0 +1,43 @@
+#include "check.h"
+#include "circuit_breaker.h"
+#include <chrono>
+#include <thread>
+
+// Threshold 3, cooldown 300 ms (lihat test_main.cpp). Pakai RITELFLOW supaya
+// state breaker tidak bocor ke test lain, dan selalu ditutup lagi di akhir.
+TEST_CASE("CircuitBreaker: buka setelah threshold, satu probe setelah cooldown") {
+  CircuitBreaker& breaker = CircuitBreaker::instance();
+  const RateFamily family = RateFamily::RITELFLOW;
+  REQUIRE(breaker.state(family) == BreakerState::CLOSED);
+
+  // Hasil non-transient (sukses, 4xx, 429) me-reset counter kegagalan
+  for (int i = 0; i < 2; i++) breaker.record(family, true);
+  breaker.record(family, false);
+  for (int i = 0; i < 2; i++) breaker.record(family, true);
+  CHECK(breaker.state(family) == BreakerState::CLOSED);
+  CHECK(breaker.admit(family));
+
+  breaker.record(family, true);
+  CHECK(breaker.state(family) == BreakerState::OPEN);
+  CHECK(breaker.shedding(family));
+  CHECK(!breaker.admit(family));
+
+  // Cooldown habis: pemanggil pertama jadi probe, sisanya tetap ditolak
+  std::this_thread::sleep_for(std::chrono::milliseconds(350));
+  CHECK(!breaker.shedding(family));
+  CHECK(breaker.admit(family));
+  CHECK(breaker.state(family) == BreakerState::HALF_OPEN);
+  CHECK(breaker.shedding(family));
+  CHECK(!breaker.admit(family));
+
+  // Probe gagal -> OPEN lagi, cooldown ulang
+  breaker.record(family, true);
+  CHECK(breaker.state(family) == BreakerState::OPEN);
+  CHECK(!breaker.admit(family));
+
+  std::this_thread::sleep_for(std::chrono::milliseconds(350));
+  CHECK(breaker.admit(family));
+  breaker.record(family, false);
+  CHECK(breaker.state(family) == BreakerState::CLOSED);
+  CHECK(!breaker.shedding(family));
+}
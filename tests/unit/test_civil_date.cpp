@@ -0,0 +1,105 @@
+#include "check.h"
+#include "civil_date.h"
+#include "bar_series.h"
+#include <cstring>
+#include <ctime>
+
+using namespace CivilDate;
+
+TEST_CASE("civil_date: round trip epoch day <-> Y-M-D, tahun 0000..9999") {
+  const int32_t first = DaysFromCivil(0, 1, 1);
+  const int32_t last = DaysFromCivil(9999, 12, 31);
+  int prevYear = 0, prevMonth = 1, prevDay = 0;
+  int mismatches = 0;
+  for (int32_t d = first; d <= last; d++) {
+    Ymd ymd = CivilFromDays(d);
+    if (DaysFromCivil(ymd.year, ymd.month, ymd.day) != d) mismatches++;
+    // Tanggal berikutnya harus tepat satu langkah kalender setelah sebelumnya
+    bool nextDay = ymd.year == prevYear && ymd.month == prevMonth && ymd.day == prevDay + 1;
+    bool nextMonth = ymd.day == 1 && ((ymd.year == prevYear && ymd.month == prevMonth + 1) ||
+                                      (ymd.year == prevYear + 1 && ymd.month == 1 && prevMonth == 12));
+    if (d > first && !nextDay && !nextMonth) mismatches++;
+    prevYear = ymd.year;
+    prevMonth = ymd.month;
+    prevDay = ymd.day;
+  }
+  CHECK(mismatches == 0);
+  CHECK(CivilFromDays(last).year == 9999);
+}
+
+TEST_CASE("civil_date: weekday & epoch Unix cocok dengan timegm") {
+  int mismatches = 0;
+  for (int32_t d = DaysFromCivil(1901, 1, 1); d <= DaysFromCivil(2099, 12, 31); d++) {
+    Ymd ymd = CivilFromDays(d);
+    std::tm tm;
+    memset(&tm, 0, sizeof(tm));
+    tm.tm_year = ymd.year - 1900;
+    tm.tm_mon = ymd.month - 1;
+    tm.tm_mday = ymd.day;
+    time_t t = timegm(&tm);
+    if (t != static_cast<time_t>(d) * 86400) mismatches++;
+    if (UnixFromDays(d) != t - kExchangeUtcOffsetSec) mismatches++;
+    if (DaysFromUnix(UnixFromDays(d)) != d || DaysFromUnix(UnixFromDays(d) - 1) != d - 1) mismatches++;
+    if (tm.tm_wday != Weekday(d)) mismatches++;
+  }
+  CHECK(mismatches == 0);
+}
+
+TEST_CASE("civil_date: WeekdaysInRange sama dengan hitung manual") {
+  int mismatches = 0;
+  const int32_t base = DaysFromCivil(2023, 12, 20);
+  for (int32_t from = base; from < base + 30; from++) {
+    for (int32_t to = from - 2; to < from + 60; to++) {
+      int32_t expected = 0;
+      for (int32_t d = from; d <= to; d++) expected += IsWeekday(d) ? 1 : 0;
+      if (WeekdaysInRange(from, to) != expected) mismatches++;
+    }
+  }
+  CHECK(mismatches == 0);
+  CHECK(WeekdaysInRange(-10, -1) == 8);     // 22-31 Des 1969 (Senin-Rabu): sebelum epoch juga benar
+}
+
+TEST_CASE("civil_date: parse / format ISO") {
+  char buf[11];
+  int mismatches = 0;
+  for (int32_t d = DaysFromCivil(1990, 1, 1); d <= DaysFromCivil(2040, 12, 31); d++) {
+    FormatIsoDate(d, buf);
+    int32_t parsed = 0;
+    if (!ParseIsoDate(buf, parsed) || parsed != d) mismatches++;
+  }
+  CHECK(mismatches == 0);
+
+  FormatIsoDate(DaysFromCivil(2024, 2, 29), buf);
+  CHECK(strcmp(buf, "2024-02-29") == 0);
+
+  int32_t d = 0;
+  CHECK(!ParseIsoDate("2024-00-10", d));
+  CHECK(!ParseIsoDate("2024-01-32", d));
+  CHECK(!ParseIsoDate("2024/01/02", d));
+  CHECK(!ParseIsoDate("2024-01-0x", d));
+  CHECK(!ParseIsoDate("2024-01-02T", d));
+}
+
+TEST_CASE("bar_series: packed EOD date <-> epoch day") {
+  const int32_t day = DaysFromCivil(2024, 4, 10);
+  DATE_TIME_INT packed = DaysToEodDate(day);
+  AmiDate a;
+  a.Date = packed;
+  CHECK(a.PackDate.Year == 2024 && a.PackDate.Month == 4 && a.PackDate.Day == 10);
+  CHECK(a.PackDate.Hour == DATE_EOD_HOURS && a.PackDate.Minute == DATE_EOD_MINUTES);
+  CHECK(EodDateToDays(packed) == day);
+  CHECK(EodDateToUnix(packed) == UnixFromDays(day));
+
+  DATE_TIME_INT parsed = 0;
+  CHECK(ParseEodDate("2024-04-10", parsed) && parsed == packed);
+  for (const char* bad : { "2024-4-10", "2024-04-1", "2024-13-01", "2024-04-32", "2024/04/10", "24-04-10", "" }) {
+    CHECK(!ParseEodDate(bad, parsed));
+  }
+
+  // Jam/menit dari AmiBroker dibuang oleh NormalizeEodDate
+  a.PackDate.Hour = 9;
+  a.PackDate.Minute = 30;
+  CHECK(a.Date != packed);
+  CHECK(NormalizeEodDate(a.Date) == packed);
+  CHECK(EodDateToDays(NormalizeEodDate(a.Date)) == day);
+}
@@ -0,0 +1,13 @@
+#ifndef TESTS_TEST_ENV_H
+#define TESTS_TEST_ENV_H
+
+#include "local_server.h"
+
+// Server lokal bersama: URL-nya dipakai sebagai PLUGIN_HOST (Config dibaca sekali
+// per proses), jadi test fetch layer cukup ganti handler.
+LocalServer& TestServer();
+
+// Folder sementara per proses (dibuat saat pertama dipanggil, dihapus di akhir run)
+const std::string& TestTempDir();
+
+#endif // TESTS_TEST_ENV_H
@@ -0,0 +1,245 @@
+#include "check.h"
+#include "test_env.h"
+#include "api_client.h"
+#include "circuit_breaker.h"
+#include "fixtures.h"
+#include "historical_proto.h"
+#include "parse_context.h"
+#include <atomic>
+#include <chrono>
+#include <thread>
+
+// Fetch layer (retry, circuit breaker, negosiasi format) terhadap stand-in
+// server yang sengaja rusak. Tiap skenario pakai keluarga endpoint sendiri
+// supaya state breaker tidak saling bocor. Retry = 2, threshold breaker = 3,
+// cooldown 300 ms (lihat test_main.cpp).
+using namespace std::chrono;
+
+static const int32_t kFrom = DayOf(2023, 1, 2);
+
+static std::string Url(const std::string& path) {
+  return TestServer().url() + path;
+}
+
+TEST_CASE("fetch: 5xx di-retry dengan backoff lalu sukses") {
+  std::atomic<int> calls{0};
+  TestServer().setHandler([&](const ServedRequest&) {
+    ServedResponse r;
+    if (++calls <= 2) {
+      r.status = 503;
+      r.body = "down";
+    } else {
+      r.body = "{\"data\":[1]}";
+    }
+    return r;
+  });
+  int status = 0;
+  auto t0 = steady_clock::now();
+  std::string body = WinHttpGetData(Url("/api/amibroker/financials?symbol=BBCA"), &status);
+  auto elapsed = duration_cast<milliseconds>(steady_clock::now() - t0).count();
+  CHECK(status == 200 && body == "{\"data\":[1]}");
+  CHECK(calls == 3);
+  CHECK(elapsed >= 125 + 250);      // Jitter 50-100% dari 250 ms lalu 500 ms
+  CHECK(CircuitBreaker::instance().state(RateFamily::FINANCIALS) == BreakerState::CLOSED);
+}
+
+TEST_CASE("fetch: 4xx permanen tidak di-retry, body error dibuang") {
+  std::atomic<int> calls{0};
+  TestServer().setHandler([&](const ServedRequest&) {
+    calls++;
+    ServedResponse r;
+    r.status = 404;
+    r.body = "{\"error\":\"not found\"}";
+    return r;
+  });
+  int status = 0;
+  std::string body = WinHttpGetData(Url("/api/amibroker/financials?symbol=NOPE"), &status);
+  CHECK(status == 404 && body.empty());
+  CHECK(calls == 1);
+}
+
+TEST_CASE("fetch: 429 menghormati Retry-After") {
+  std::atomic<int> calls{0};
+  TestServer().setHandler([&](const ServedRequest&) {
+    ServedResponse r;
+    if (++calls == 1) {
+      r.status = 429;
+      r.retryAfterSec = 1;
+    } else {
+      r.body = "ok";
+    }
+    return r;
+  });
+  int status = 0;
+  auto t0 = steady_clock::now();
+  CHECK(WinHttpGetData(Url("/api/amibroker/ritelflow?symbol=BBCA"), &status) == "ok");
+  CHECK(duration_cast<milliseconds>(steady_clock::now() - t0).count() >= 1000);
+  CHECK(calls == 2);
+}
+
+TEST_CASE("fetch: breaker terbuka setelah threshold, request ditolak, probe setelah cooldown") {
+  std::atomic<int> calls{0};
+  std::atomic<bool> healthy{false};
+  TestServer().setHandler([&](const ServedRequest&) {
+    calls++;
+    ServedResponse r;
+    r.status = healthy ? 200 : 500;
+    r.body = healthy ? "back" : "boom";
+    return r;
+  });
+  const std::string url = Url("/api/amibroker/ownership?symbol=BBCA");
+  int status = -1;
+  CHECK(WinHttpGetData(url, &status).empty() && status == 500);
+  CHECK(calls == 3);      // 1 + 2 retry, semuanya 5xx = threshold
+  CHECK(CircuitBreaker::instance().state(RateFamily::OWNERSHIP) == BreakerState::OPEN);
+  CHECK(CircuitBreaker::instance().shedding(RateFamily::OWNERSHIP));
+
+  // Selama OPEN: tidak ada yang sampai ke server
+  CHECK(WinHttpGetData(url, &status).empty() && status == 0);
+  CHECK(calls == 3);
+
+  // Cooldown habis, backend sudah pulih: satu probe lewat lalu CLOSED
+  healthy = true;
+  std::this_thread::sleep_for(milliseconds(350));
+  CHECK(WinHttpGetData(url, &status) == "back" && status == 200);
+  CHECK(calls == 4);
+  CHECK(CircuitBreaker::instance().state(RateFamily::OWNERSHIP) == BreakerState::CLOSED);
+}
+
+TEST_CASE("fetch: body compressed terpotong dihitung gagal transient") {
+  const std::string body = ChartbitJson(MakeSourceBars(kFrom, 200));
+  std::atomic<int> calls{0};
+  TestServer().setHandler([&](const ServedRequest&) {
+    calls++;
+    ServedResponse r;
+    r.body = body;
+    r.encoding = "gzip";
+    r.wireLimit = 200;      // Bagian awal stream gzip saja: tidak pernah sampai Z_STREAM_END
+    return r;
+  });
+  int status = -1;
+  CHECK(WinHttpGetData(Url("/other/flaky"), &status).empty() && status == 0);
+  CHECK(calls == 3);      // Request yang sudah terkirim tidak diulang oleh transport, hanya oleh retry
+  CHECK(CircuitBreaker::instance().state(RateFamily::OTHER) == BreakerState::OPEN);
+  std::this_thread::sleep_for(milliseconds(350));
+}
+
+// ---- Historical: negosiasi protobuf / JSON menghasilkan baris yang sama
+
+static ServedResponse HistoricalResponse(const std::vector<SourceBar>& bars, const ServedRequest& req, bool honourAccept) {
+  ServedResponse r;
+  if (honourAccept && req.accept.find(kHistoricalProtoType) != std::string::npos) {
+    r.contentType = kHistoricalProtoType;
+    r.body = HistoricalProto(bars);
+  } else {
+    r.body = ChartbitJson(bars);
+  }
+  r.encoding = "gzip";
+  r.chunked = true;
+  return r;
+}
+
+TEST_CASE("fetchHistorical: protobuf & JSON (backend lama) memberi baris identik") {
+  const auto src = MakeSourceBars(kFrom, 500);
+  const auto expected = ToQuotations(src);
+  std::string seenAccept;
+
+  TestServer().setHandler([&](const ServedRequest& req) {
+    seenAccept = req.accept;
+    return HistoricalResponse(src, req, true);
+  });
+  auto proto = fetchHistorical("BBCA", "2023-01-02", "2024-12-31");
+  CHECK(seenAccept == "application/x-protobuf, application/json;q=0.5");
+  CHECK(SameBars(proto, expected));
+
+  TestServer().setHandler([&](const ServedRequest& req) { return HistoricalResponse(src, req, false); });
+  auto json = fetchHistorical("BBCA", "2023-01-02", "2024-12-31");
+  CHECK(SameBars(json, expected));
+}
+
+TEST_CASE("fetchHistorical: protobuf rusak diulang sekali sebagai JSON") {
+  const auto src = MakeSourceBars(kFrom, 120);
+  std::atomic<int> calls{0};
+  TestServer().setHandler([&](const ServedRequest& req) {
+    calls++;
+    ServedResponse r = HistoricalResponse(src, req, true);
+    if (r.contentType == kHistoricalProtoType) r.body.resize(r.body.size() / 2);
+    return r;
+  });
+  auto bars = fetchHistorical("TLKM", "2023-01-02", "2023-12-31");
+  CHECK(calls == 2);
+  CHECK(SameBars(bars, ToQuotations(src)));
+}
+
+// ---- Historical: record chartbit di-parse sambil body masih streaming
+
+TEST_CASE("fetchHistorical: record utuh walau batas chunk jatuh di tengah record") {
+  const auto src = MakeSourceBars(kFrom, 500);
+  for (const char* encoding : { "", "gzip" }) {
+    TestServer().setHandler([&](const ServedRequest&) {
+      ServedResponse r;
+      r.body = ChartbitJson(src);
+      r.encoding = encoding;
+      r.chunked = true;
+      return r;
+    });
+    CHECK(SameBars(fetchHistorical("BBCA", "2023-01-02", "2024-12-31"), ToQuotations(src)));
+  }
+}
+
+TEST_CASE("fetchHistorical: JSON terpotong / tanpa chartbit tidak disimpan sebagian") {
+  const auto src = MakeSourceBars(kFrom, 120);
+  TestServer().setHandler([&](const ServedRequest&) {
+    ServedResponse r;
+    r.body = ChartbitJson(src);
+    r.body.resize(r.body.size() - 40);      // Array tidak pernah ditutup
+    return r;
+  });
+  CHECK(fetchHistorical("ASII", "2023-01-02", "2023-12-31").empty());
+
+  TestServer().setHandler([&](const ServedRequest&) {
+    ServedResponse r;
+    r.body = "{\"status\":\"ok\",\"chartbit\":null}";
+    return r;
+  });
+  CHECK(fetchHistorical("ASII", "2023-01-02", "2023-12-31").empty());
+
+  TestServer().setHandler([&](const ServedRequest&) {
+    ServedResponse r;
+    r.body = "{\"status\":\"ok\",\"chartbit\":[]}";
+    return r;
+  });
+  CHECK(fetchHistorical("ASII", "2023-01-02", "2023-12-31").empty());
+}
+
+TEST_CASE("ParseContext: steady state tidak realokasi buffer maupun parser") {
+  const std::string big = ChartbitJson(MakeSourceBars(kFrom, 2000));
+  const std::string small = ChartbitJson(MakeSourceBars(kFrom, 300));
+  std::atomic<bool> useBig{true};
+  TestServer().setHandler([&](const ServedRequest&) {
+    ServedResponse r;
+    r.body = useBig ? big : small;
+    r.encoding = "gzip";
+    r.chunked = true;
+    return r;
+  });
+
+  // Pemanasan: body terbesar menentukan kapasitas
+  ParseContext& ctx = ParseContext::forThread();
+  const std::string url = Url("/api/amibroker/emitenlist");
+  REQUIRE(WinHttpGetInto(url, ctx));
+  CHECK(ctx.body() == big);
+  CHECK(ctx.iterate().type() == simdjson::ondemand::json_type::object);
+
+  const ParseAllocStats before = GetParseAllocStats();
+  for (int i = 0; i < 20; i++) {
+    useBig = i % 2 == 1;
+    REQUIRE(WinHttpGetInto(url, ctx));
+    CHECK(ctx.iterate().type() == simdjson::ondemand::json_type::object);
+  }
+  const ParseAllocStats after = GetParseAllocStats();
+  CHECK(after.parses - before.parses == 20);
+  CHECK(after.bufferGrowths == before.bufferGrowths);
+  CHECK(after.parserGrowths == before.parserGrowths);
+  CHECK(after.transportGrowths == before.transportGrowths);     // Wire buffer & state zlib dipakai ulang
+}
@@ -0,0 +1,339 @@
+#include "check.h"
+#include "fetch_pool.h"
+#include <chrono>
+#include <condition_variable>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+// ---- Runner uji: tugas simbol "HOLD" menahan worker sampai ReleaseHold(),
+// "THROW" melempar exception non-std
+namespace {
+std::mutex g_mtx;
+std::condition_variable g_cv;
+bool g_released = false;
+std::vector<std::string> g_ran;
+
+bool TestRunner(FetchTask& task) {
+  if (task.symbol == "THROW") throw 42;      // Bukan std::exception
+  std::unique_lock<std::mutex> lock(g_mtx);
+  if (task.symbol == "HOLD") g_cv.wait(lock, [] { return g_released; });
+  g_ran.push_back(task.symbol);
+  return true;
+}
+
+void ReleaseHold() {
+  std::lock_guard<std::mutex> lock(g_mtx);
+  g_released = true;
+  g_cv.notify_all();
+}
+
+void ResetRunner() {
+  std::lock_guard<std::mutex> lock(g_mtx);
+  g_released = false;
+  g_ran.clear();
+}
+
+FetchTask Task(const char* symbol, SymbolId id, FetchPriority priority, CancelToken cancel = nullptr) {
+  FetchTask t;
+  t.type = FetchTaskType::GET_FINANCIALS;
+  t.priority = priority;
+  t.symbol = symbol;
+  t.symbolId = id;
+  t.cancel = std::move(cancel);
+  return t;
+}
+
+// ID simbol sintetis (tidak lewat SymbolTable), unik per test supaya key tidak bentrok
+uint64_t Key(SymbolId id) {
+  return MakeTaskKey(FetchTaskType::GET_FINANCIALS, id, kNoSymbol);
+}
+
+void StartSingleWorker(int agingInterval = FetchPoolConfig().agingInterval) {
+  FetchPoolConfig cfg;
+  cfg.workers = 1;
+  cfg.agingInterval = agingInterval;
+  FetchPool::instance().start(cfg, &TestRunner);
+}
+
+// Tunggu worker benar-benar memegang tugas HOLD
+void WaitRunning(uint64_t key) {
+  while (!(TaskRegistry::instance().find(key) && TaskRegistry::instance().find(key)->state() == FlightState::RUNNING)) {
+    std::this_thread::sleep_for(std::chrono::milliseconds(1));
+  }
+}
+} // namespace
+
+TEST_CASE("TaskKey: candle range & param tidak bertabrakan") {
+  CHECK(MakeCandleKey(5) == MakeCandleKey(5, kTrailingRange));
+  CHECK(MakeCandleKey(5, 19000) != MakeCandleKey(5));
+  CHECK(MakeCandleKey(5, 19000) != MakeCandleKey(6, 19000));
+  CHECK(MakeCandleKey(5, 0) != MakeTaskKey(FetchTaskType::GET_CANDLES, 5, kNoSymbol));
+  CHECK(MakeTaskKey(FetchTaskType::GET_BROKER_FLOW, 5, 7) != MakeTaskKey(FetchTaskType::GET_RITEL_FLOW, 5, 7));
+
+  FetchTask t;
+  t.type = FetchTaskType::GET_CANDLES;
+  t.symbolId = 9;
+  t.rangeDay = 19500;
+  CHECK(TaskKeyOf(t) == MakeCandleKey(9, 19500));
+  t.type = FetchTaskType::GET_BROKER_FLOW;
+  t.paramId = 3;
+  CHECK(TaskKeyOf(t) == MakeTaskKey(FetchTaskType::GET_BROKER_FLOW, 9, 3));
+}
+
+TEST_CASE("TaskRegistry: slot selesai didaur ulang, flight in-flight tidak pernah dibuang") {
+  TaskRegistry& reg = TaskRegistry::instance();
+  const uint64_t base = MakeTaskKey(FetchTaskType::GET_OWNERSHIP_CORP, 0, 0);
+
+  // Flight yang tetap antri selama churn
+  std::vector<std::shared_ptr<TaskFlight>> pinned;
+  for (uint64_t i = 0; i < 100; i++) {
+    bool created = false;
+    pinned.push_back(reg.begin(base + i, created));
+    CHECK(created);
+  }
+
+  // Jauh melebihi kSlots: tanpa daur ulang tabel sudah penuh
+  int unpublished = 0;
+  for (uint64_t i = 100; i < 4 * TaskRegistry::kSlots; i++) {
+    bool created = false;
+    auto flight = reg.begin(base + i, created);
+    if (!created || reg.find(base + i) != flight) unpublished++;
+    flight->complete(true);
+  }
+  CHECK(unpublished == 0);
+
+  for (uint64_t i = 0; i < 100; i++) {
+    bool created = true;
+    CHECK(reg.find(base + i) == pinned[i]);
+    CHECK(reg.begin(base + i, created) == pinned[i] && !created);
+    pinned[i]->complete(false);
+  }
+
+  // Selesai: key yang sama boleh dijadwalkan ulang
+  bool created = false;
+  auto again = reg.begin(base + 1, created);
+  CHECK(created && again != pinned[1]);
+  again->complete(true);
+}
+
+TEST_CASE("FetchPool: key sama didedupe, semua peminta dapat future yang sama") {
+  ResetRunner();
+  StartSingleWorker();
+  FetchPool& pool = FetchPool::instance();
+
+  std::shared_future<bool> hold, a, b;
+  CHECK(pool.submit(Key(9001), Task("HOLD", 9001, FetchPriority::INTERACTIVE), &hold));
+  WaitRunning(Key(9001));
+
+  CHECK(pool.submit(Key(9002), Task("DUP", 9002, FetchPriority::SCAN), &a));
+  CHECK(!pool.submit(Key(9002), Task("DUP", 9002, FetchPriority::SCAN), &b));     // Masih antri
+  CHECK(!pool.submit(Key(9001), Task("HOLD", 9001, FetchPriority::SCAN), &b));    // Sedang jalan
+  ReleaseHold();
+  CHECK(hold.get() && a.get());
+  pool.stop();
+
+  std::lock_guard<std::mutex> lock(g_mtx);
+  CHECK(g_ran == (std::vector<std::string>{ "HOLD", "DUP" }));
+}
+
+TEST_CASE("FetchPool: tugas antri mengadopsi token peminta terbaru & dinaikkan kelasnya") {
+  ResetRunner();
+  StartSingleWorker();
+  FetchPool& pool = FetchPool::instance();
+
+  std::shared_future<bool> hold, bg, scan1, scan2, dropped;
+  CHECK(pool.submit(Key(9101), Task("HOLD", 9101, FetchPriority::INTERACTIVE), &hold));
+  WaitRunning(Key(9101));
+
+  // Antri: BG (extradata), lalu SCAN dengan token lama
+  CancelToken oldToken = MakeCancelToken();
+  CancelToken newToken = MakeCancelToken();
+  CHECK(pool.submit(Key(9102), Task("BG", 9102, FetchPriority::EXTRADATA), &bg));
+  CHECK(pool.submit(Key(9103), Task("SCAN", 9103, FetchPriority::EXTRADATA, oldToken), &scan1));
+  // Peminta baru (chart interaktif) untuk key yang sama: adopsi token + naik kelas
+  CHECK(!pool.submit(Key(9103), Task("SCAN", 9103, FetchPriority::INTERACTIVE, newToken), &scan2));
+  CHECK(pool.submit(Key(9104), Task("DROP", 9104, FetchPriority::EXTRADATA, oldToken), &dropped));
+  oldToken->cancelled = true;     // Peminta lama pindah chart
+
+  ReleaseHold();
+  CHECK(hold.get());
+  CHECK(scan1.get() && scan2.get());
+  CHECK(bg.get());
+  CHECK(!dropped.get());
+  CHECK(TaskRegistry::instance().find(Key(9104))->state() == FlightState::CANCELLED);
+  pool.stop();
+
+  std::lock_guard<std::mutex> lock(g_mtx);
+  CHECK(g_ran == (std::vector<std::string>{ "HOLD", "SCAN", "BG" }));
+}
+
+TEST_CASE("FetchPool: chart & scan berbagi satu flight, batal hanya kalau keduanya batal") {
+  ResetRunner();
+  StartSingleWorker();
+  FetchPool& pool = FetchPool::instance();
+
+  std::shared_future<bool> hold, shared, both, pinned, promoted;
+  CHECK(pool.submit(Key(9801), Task("HOLD", 9801, FetchPriority::INTERACTIVE), &hold));
+  WaitRunning(Key(9801));
+
+  // Scan dulu, lalu chart untuk simbol yang sama; chart pindah -> scan masih butuh
+  CancelToken scan = MakeCancelToken();
+  CancelToken chart = MakeCancelToken();
+  CHECK(pool.submit(Key(9802), Task("SHARED", 9802, FetchPriority::SCAN, scan), &shared));
+  CHECK(!pool.submit(Key(9802), Task("SHARED", 9802, FetchPriority::INTERACTIVE, chart), &shared));
+
+  // Dua peminta, dua-duanya batal -> dibuang
+  CancelToken scan2 = MakeCancelToken();
+  CancelToken chart2 = MakeCancelToken();
+  CHECK(pool.submit(Key(9803), Task("BOTH", 9803, FetchPriority::SCAN, scan2), &both));
+  CHECK(pool.promote(Key(9803), FetchPriority::INTERACTIVE, chart2));
+
+  // Peminta tanpa token (revalidasi) tidak menghapus token yang ada, dan tidak pernah batal
+  CancelToken chart3 = MakeCancelToken();
+  CHECK(pool.submit(Key(9804), Task("PINNED", 9804, FetchPriority::INTERACTIVE, chart3), &pinned));
+  CHECK(!pool.submit(Key(9804), Task("PINNED", 9804, FetchPriority::BACKGROUND), &pinned));
+
+  // Promote dengan token baru setelah token lama batal: tugas hidup lagi
+  CancelToken stale = MakeCancelToken();
+  CancelToken fresh = MakeCancelToken();
+  CHECK(pool.submit(Key(9805), Task("PROMOTED", 9805, FetchPriority::SCAN, stale), &promoted));
+  stale->cancelled = true;
+  CHECK(pool.promote(Key(9805), FetchPriority::INTERACTIVE, fresh));
+
+  chart->cancelled = true;
+  scan2->cancelled = true;
+  chart2->cancelled = true;
+  chart3->cancelled = true;
+  ReleaseHold();
+  CHECK(hold.get());
+  CHECK(shared.get());
+  CHECK(!both.get());
+  CHECK(TaskRegistry::instance().find(Key(9803))->state() == FlightState::CANCELLED);
+  CHECK(pinned.get());
+  CHECK(promoted.get());
+  pool.stop();
+
+  std::lock_guard<std::mutex> lock(g_mtx);
+  CHECK(g_ran == (std::vector<std::string>{ "HOLD", "SHARED", "PINNED", "PROMOTED" }));
+}
+
+TEST_CASE("FetchPool: chart interaktif baru langsung jalan walau >100 SCAN sudah lama antri") {
+  ResetRunner();
+  StartSingleWorker();
+  FetchPool& pool = FetchPool::instance();
+
+  std::shared_future<bool> hold, chart;
+  CHECK(pool.submit(Key(9401), Task("HOLD", 9401, FetchPriority::INTERACTIVE), &hold));
+  WaitRunning(Key(9401));
+  const int scans = 150;
+  std::vector<std::shared_future<bool>> scan(scans);
+  for (int i = 0; i < scans; i++) {
+    CHECK(pool.submit(Key(9500 + i), Task("SCAN", 9500 + i, FetchPriority::SCAN), &scan[i]));
+  }
+  // Umur antrian tidak memberi prioritas: yang dibatasi jumlah pop, bukan waktu
+  std::this_thread::sleep_for(std::chrono::milliseconds(5100));
+  CHECK(pool.submit(Key(9402), Task("CHART", 9402, FetchPriority::INTERACTIVE), &chart));
+
+  ReleaseHold();
+  CHECK(chart.get());
+  for (auto& f : scan) CHECK(f.get());
+  pool.stop();
+
+  std::lock_guard<std::mutex> lock(g_mtx);
+  REQUIRE(g_ran.size() == static_cast<size_t>(scans + 2));
+  CHECK(g_ran[0] == "HOLD" && g_ran[1] == "CHART");
+}
+
+TEST_CASE("FetchPool: aging terbatas, satu tugas kelas bawah per N pop kelas atas") {
+  ResetRunner();
+  StartSingleWorker(4);
+  FetchPool& pool = FetchPool::instance();
+
+  std::shared_future<bool> hold;
+  std::vector<std::shared_future<bool>> all;
+  CHECK(pool.submit(Key(9701), Task("HOLD", 9701, FetchPriority::INTERACTIVE), &hold));
+  WaitRunning(Key(9701));
+  for (int i = 0; i < 3; i++) {
+    all.emplace_back();
+    CHECK(pool.submit(Key(9710 + i), Task("S", 9710 + i, FetchPriority::SCAN), &all.back()));
+  }
+  for (int i = 0; i < 12; i++) {
+    all.emplace_back();
+    CHECK(pool.submit(Key(9720 + i), Task("I", 9720 + i, FetchPriority::INTERACTIVE), &all.back()));
+  }
+
+  ReleaseHold();
+  for (auto& f : all) CHECK(f.get());
+  pool.stop();
+
+  std::lock_guard<std::mutex> lock(g_mtx);
+  std::string order;
+  for (const auto& symbol : g_ran) order += symbol;
+  CHECK(order == "HOLDIIIISIIIISIIIIS");
+}
+
+TEST_CASE("FetchPool: endpoint yang di-shed gagal tanpa menjalankan runner") {
+  ResetRunner();
+  FetchPoolConfig cfg;
+  cfg.workers = 1;
+  cfg.shed = [](FetchEndpoint endpoint) { return endpoint == FetchEndpoint::FINANCIALS; };
+  FetchPool& pool = FetchPool::instance();
+  pool.start(cfg, &TestRunner);
+
+  std::shared_future<bool> shed, ran;
+  FetchTask other = Task("OWN", 9202, FetchPriority::INTERACTIVE);
+  other.type = FetchTaskType::GET_OWNERSHIP_CORP;
+  CHECK(pool.submit(Key(9201), Task("SHED", 9201, FetchPriority::INTERACTIVE), &shed));
+  CHECK(pool.submit(MakeTaskKey(other.type, 9202, kNoSymbol), other, &ran));
+  CHECK(!shed.get());
+  CHECK(ran.get());
+  pool.stop();
+
+  std::lock_guard<std::mutex> lock(g_mtx);
+  CHECK(g_ran == (std::vector<std::string>{ "OWN" }));
+}
+
+TEST_CASE("FetchPool: stop() membatalkan tugas antri, penunggu tidak hang") {
+  ResetRunner();
+  StartSingleWorker();
+  FetchPool& pool = FetchPool::instance();
+
+  std::shared_future<bool> hold;
+  std::vector<std::shared_future<bool>> queued(3);
+  CHECK(pool.submit(Key(9301), Task("HOLD", 9301, FetchPriority::INTERACTIVE), &hold));
+  WaitRunning(Key(9301));
+  for (int i = 0; i < 3; i++) {
+    CHECK(pool.submit(Key(9302 + i), Task("QUEUED", 9302 + i, FetchPriority::EXTRADATA), &queued[i]));
+  }
+
+  // stop() menunggu HOLD selesai (join), tapi tugas antri sudah dilepas sebelumnya
+  std::thread stopper([&] { pool.stop(); });
+  for (int i = 0; i < 3; i++) {
+    REQUIRE(queued[i].wait_for(std::chrono::seconds(2)) == std::future_status::ready);
+    CHECK(!queued[i].get());
+    CHECK(TaskRegistry::instance().find(Key(9302 + i))->state() == FlightState::CANCELLED);
+  }
+  ReleaseHold();
+  stopper.join();
+  CHECK(hold.get());
+  CHECK(!pool.running());
+
+  std::lock_guard<std::mutex> lock(g_mtx);
+  CHECK(g_ran == (std::vector<std::string>{ "HOLD" }));
+}
+
+TEST_CASE("FetchPool: exception non-std menggagalkan flight, worker tetap jalan") {
+  ResetRunner();
+  StartSingleWorker();
+  FetchPool& pool = FetchPool::instance();
+
+  std::shared_future<bool> thrown, next;
+  CHECK(pool.submit(Key(9311), Task("THROW", 9311, FetchPriority::INTERACTIVE), &thrown));
+  CHECK(pool.submit(Key(9312), Task("NEXT", 9312, FetchPriority::INTERACTIVE), &next));
+  CHECK(!thrown.get());
+  CHECK(TaskRegistry::instance().find(Key(9311))->state() == FlightState::FAILED);
+  CHECK(next.get());
+  pool.stop();
+}
@@ -0,0 +1,108 @@
+#include "check.h"
+#include "gap_planner.h"
+#include "civil_date.h"
+#include "fixtures.h"
+#include <vector>
+
+using CivilDate::DaysFromCivil;
+
+static std::vector<Quotation> WeekdayBars(int32_t from, int32_t to) {
+  std::vector<Quotation> bars;
+  for (int32_t d = from; d <= to; d++) {
+    if (CivilDate::IsWeekday(d)) bars.push_back(MakeBar(d, 100.0f));
+  }
+  return bars;
+}
+
+TEST_CASE("GapPlanner: seri kosong = satu rentang lookback penuh") {
+  FetchRange out[GapPlanner::kMaxRanges];
+  const int32_t today = DaysFromCivil(2024, 6, 12);
+  CHECK(GapPlanner::plan(nullptr, 0, today, true, out) == 1);
+  CHECK(out[0].fromDay == today - GapPlanner::kDefaultLookbackDays && out[0].toDay == today && out[0].trailing);
+  CHECK(GapPlanner::plan(nullptr, 0, today, true, out, 0) == 0);
+}
+
+TEST_CASE("GapPlanner: seri lengkap sampai hari ini / kemarin") {
+  FetchRange out[GapPlanner::kMaxRanges];
+  const int32_t wed = DaysFromCivil(2024, 6, 12);
+  auto bars = WeekdayBars(wed - 100, wed);
+  CHECK(GapPlanner::plan(bars.data(), bars.size(), wed, true, out) == 0);
+
+  // Bar terakhir kemarin: hari ini perlu di-fetch, kecuali live quote sudah menyuplai
+  bars.pop_back();
+  CHECK(GapPlanner::plan(bars.data(), bars.size(), wed, false, out) == 0);
+  REQUIRE(GapPlanner::plan(bars.data(), bars.size(), wed, true, out) == 1);
+  CHECK(out[0].fromDay == wed - 1 && out[0].toDay == wed && out[0].trailing);
+
+  // Senin pagi, bar terakhir Jumat: akhir pekan bukan lubang
+  const int32_t mon = DaysFromCivil(2024, 6, 10);
+  auto toFriday = WeekdayBars(mon - 60, mon - 3);
+  CHECK(GapPlanner::plan(toFriday.data(), toFriday.size(), mon, false, out) == 0);
+  CHECK(GapPlanner::plan(toFriday.data(), toFriday.size(), mon, true, out) == 1);
+}
+
+TEST_CASE("GapPlanner: hanya libur bursa & lubang 1-2 hari yang dilewati") {
+  FetchRange out[GapPlanner::kMaxRanges];
+  const int32_t today = DaysFromCivil(2024, 6, 28);
+  const int32_t start = DaysFromCivil(2024, 1, 1);
+  auto withHole = [&](int32_t holeFrom, int32_t holeTo) {
+    auto bars = WeekdayBars(start, holeFrom - 1);
+    auto after = WeekdayBars(holeTo + 1, today);
+    bars.insert(bars.end(), after.begin(), after.end());
+    return bars;
+  };
+
+  // Libur Lebaran 8-15 April (6 hari kerja, semuanya di tabel libur bursa)
+  const int32_t lebaran = DaysFromCivil(2024, 4, 8);
+  CHECK(GapPlanner::tradingDaysInRange(lebaran, DaysFromCivil(2024, 4, 15)) == 0);
+  auto holiday = withHole(lebaran, DaysFromCivil(2024, 4, 15));
+  CHECK(GapPlanner::plan(holiday.data(), holiday.size(), today, true, out) == 0);
+
+  // Lebaran + 16-17 April (hari bursa) hilang: lubang di-fetch
+  auto gap = withHole(lebaran, DaysFromCivil(2024, 4, 17));
+  REQUIRE(GapPlanner::plan(gap.data(), gap.size(), today, true, out) == 1);
+  CHECK(out[0].fromDay == lebaran - 3 + 1);      // Sehari setelah Jumat 5 April
+  CHECK(out[0].toDay == DaysFromCivil(2024, 4, 17) && !out[0].trailing);
+
+  // Lubang 1-2 hari kerja di luar tabel tetap dianggap libur
+  auto shortGap = withHole(DaysFromCivil(2024, 6, 4), DaysFromCivil(2024, 6, 5));
+  CHECK(GapPlanner::plan(shortGap.data(), shortGap.size(), today, true, out) == 0);
+
+  // 3 hari bursa biasa hilang: bukan libur
+  auto tradingGap = withHole(DaysFromCivil(2024, 6, 4), DaysFromCivil(2024, 6, 6));
+  REQUIRE(GapPlanner::plan(tradingGap.data(), tradingGap.size(), today, true, out) == 1);
+  CHECK(out[0].fromDay == DaysFromCivil(2024, 6, 4) && out[0].toDay == DaysFromCivil(2024, 6, 6));
+}
+
+TEST_CASE("GapPlanner: ekor berhenti di kemarin kalau hari ini dari live quote") {
+  FetchRange out[GapPlanner::kMaxRanges];
+  const int32_t fri = DaysFromCivil(2024, 6, 14);
+  auto bars = WeekdayBars(fri - 60, fri - 4);      // Terakhir Senin
+
+  REQUIRE(GapPlanner::plan(bars.data(), bars.size(), fri, false, out) == 1);
+  CHECK(out[0].fromDay == fri - 4 && out[0].toDay == fri - 1 && out[0].trailing);
+  REQUIRE(GapPlanner::plan(bars.data(), bars.size(), fri, true, out) == 1);
+  CHECK(out[0].toDay == fri);
+  REQUIRE(GapPlanner::plan(nullptr, 0, fri, false, out) == 1);
+  CHECK(out[0].toDay == fri - 1);
+
+  // Hari ini libur bursa (Idul Adha): ekor yang cuma kurang hari ini tidak di-fetch
+  const int32_t eid = DaysFromCivil(2024, 6, 17);
+  auto toFriday = WeekdayBars(eid - 60, eid - 3);
+  CHECK(GapPlanner::plan(toFriday.data(), toFriday.size(), eid, true, out) == 0);
+}
+
+TEST_CASE("GapPlanner: kebanyakan lubang melebarkan rentang terakhir") {
+  FetchRange out[3];
+  const int32_t start = DaysFromCivil(2023, 1, 2);
+  std::vector<Quotation> bars;
+  for (int block = 0; block < 6; block++) {
+    auto part = WeekdayBars(start + block * 30, start + block * 30 + 6);    // 23 hari kosong tiap blok
+    bars.insert(bars.end(), part.begin(), part.end());
+  }
+  const int32_t today = start + 400;
+  REQUIRE(GapPlanner::plan(bars.data(), bars.size(), today, true, out, 3) == 3);
+  CHECK(!out[0].trailing && !out[1].trailing);
+  CHECK(out[2].trailing && out[2].toDay == today);
+  CHECK(out[2].fromDay == start + 2 * 30 + 7);      // Lubang ke-3 s/d ekor jadi satu request
+}
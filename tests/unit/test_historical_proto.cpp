@@ -0,0 +1,69 @@
+#include "check.h"
+#include "historical_proto.h"
+#include "bar_series.h"
+#include "fixtures.h"
+
+static const int32_t kFirstDay = DayOf(2022, 3, 1);
+
+// Pesan minimal: first_day = 1, day_delta [0, 1], close [10, +1] (packed, zigzag)
+static const std::string kMinimal("\x08\x02" "\x12\x02\x00\x01" "\x22\x02\x14\x02", 10);
+
+TEST_CASE("historical_proto: packed & unpacked decode ke baris yang sama") {
+  auto src = MakeSourceBars(kFirstDay, 500);
+  auto expected = ToQuotations(src);
+  std::vector<Quotation> out;
+
+  std::string packed = HistoricalProto(src, true);
+  REQUIRE(DecodeHistoricalBars(packed.data(), packed.size(), out));
+  CHECK(SameBars(out, expected));
+
+  std::string unpacked = HistoricalProto(src, false);
+  CHECK(unpacked.size() > packed.size());
+  REQUIRE(DecodeHistoricalBars(unpacked.data(), unpacked.size(), out));
+  CHECK(SameBars(out, expected));
+
+  CHECK(DecodeHistoricalBars("", 0, out) && out.empty());
+}
+
+TEST_CASE("historical_proto: kolom opsional boleh tidak dikirim") {
+  std::vector<Quotation> out;
+  REQUIRE(DecodeHistoricalBars(kMinimal.data(), kMinimal.size(), out));
+  REQUIRE(out.size() == 2);
+  CHECK(out[0].DateTime.Date == DaysToEodDate(1) && out[1].DateTime.Date == DaysToEodDate(2));
+  CHECK(out[0].Price == 10.0f && out[1].Price == 11.0f);
+  CHECK(out[1].Open == 11.0f && out[1].High == 11.0f && out[1].Volume == 0.0f && out[1].AuxData2 == 0.0f);
+
+  std::string scaled = kMinimal + std::string("\x18\x02", 2);       // price_decimals = 2
+  REQUIRE(DecodeHistoricalBars(scaled.data(), scaled.size(), out));
+  CHECK(out[0].Price == 0.1f && out[1].Price == 0.11f);
+}
+
+TEST_CASE("historical_proto: field tak dikenal dari backend baru dilewati") {
+  auto src = MakeSourceBars(kFirstDay, 20);
+  // tag 15 varint + tag 16 length-delimited, di depan dan di belakang pesan
+  const std::string unknown("\x78\x05\x82\x01\x03" "abc", 8);
+  std::string body = unknown + HistoricalProto(src, true) + unknown;
+  std::vector<Quotation> out;
+  REQUIRE(DecodeHistoricalBars(body.data(), body.size(), out));
+  CHECK(SameBars(out, ToQuotations(src)));
+}
+
+TEST_CASE("historical_proto: pesan rusak / kolom tidak sejajar ditolak") {
+  auto src = MakeSourceBars(kFirstDay, 50);
+  std::string body = HistoricalProto(src, true);
+  std::vector<Quotation> out;
+
+  CHECK(!DecodeHistoricalBars(body.data(), body.size() - 3, out));        // Terpotong di tengah kolom
+
+  std::string badVolume = kMinimal + std::string("\x42\x01\x05", 3);     // volume 1 nilai untuk 2 bar
+  CHECK(!DecodeHistoricalBars(badVolume.data(), badVolume.size(), out));
+
+  std::string noClose = kMinimal.substr(0, 6);
+  CHECK(!DecodeHistoricalBars(noClose.data(), noClose.size(), out));
+
+  std::string badDecimals = kMinimal + std::string("\x18\x0a", 2);       // 10 desimal > 9
+  CHECK(!DecodeHistoricalBars(badDecimals.data(), badDecimals.size(), out));
+
+  std::string wrongWire("\x25\x00\x00\x00\x00", 5);                      // close sebagai fixed32
+  CHECK(!DecodeHistoricalBars(wrongWire.data(), wrongWire.size(), out));
+}
@@ -0,0 +1,219 @@
+#include "check.h"
+#include "test_env.h"
+#include "fixtures.h"
+#include "http_transport.h"
+#include <chrono>
+#include <thread>
+
+// Transport POSIX langsung (tanpa retry/breaker) terhadap server lokal
+static std::string LargeBody() {
+  std::string body;
+  for (int i = 0; body.size() < 200000; i++) body += "{\"row\":" + std::to_string(i) + ",\"pad\":\"abcdefghij\"},";
+  return body;
+}
+
+static bool Get(const std::string& path, HttpResponse& out, const char* accept = nullptr) {
+  return DefaultHttpTransport().get(TestServer().url() + path, 2000, out, nullptr, accept);
+}
+
+TEST_CASE("transport: Content-Length, chunked, dan close-delimited") {
+  const std::string body = LargeBody();
+  HttpResponse res;
+  for (int mode = 0; mode < 3; mode++) {
+    TestServer().setHandler([&](const ServedRequest&) {
+      ServedResponse r;
+      r.body = body;
+      r.chunked = mode == 1;
+      r.noLength = mode == 2;
+      return r;
+    });
+    REQUIRE(Get("/plain", res));
+    CHECK(res.status == 200);
+    CHECK(res.body == body);
+    CHECK(!res.compressed && res.wireBytes == body.size());
+    CHECK(res.contentType == "application/json");
+  }
+}
+
+TEST_CASE("transport: gzip / deflate / raw deflate di-decode sambil streaming") {
+  const std::string body = LargeBody();
+  HttpResponse res;
+  std::string seenEncoding;
+  const HttpTransferTotals before = GetHttpTransferTotals();
+  size_t wire = 0;
+  for (const char* encoding : { "gzip", "deflate", "raw-deflate" }) {
+    for (bool chunked : { false, true }) {
+      TestServer().setHandler([&](const ServedRequest& req) {
+        seenEncoding = req.acceptEncoding;
+        ServedResponse r;
+        r.body = body;
+        r.encoding = encoding;
+        r.chunked = chunked;
+        return r;
+      });
+      REQUIRE(Get("/compressed", res));
+      CHECK(res.status == 200 && res.body == body);
+      CHECK(res.compressed);
+      CHECK(res.wireBytes == Compress(body, encoding).size());
+      CHECK(res.wireBytes * 5 < body.size());
+      wire += res.wireBytes;
+    }
+  }
+  CHECK(seenEncoding == "gzip, deflate");
+
+  // Total transfer (dilaporkan di log plugin) memisahkan byte wire & hasil decode
+  const HttpTransferTotals after = GetHttpTransferTotals();
+  CHECK(after.responses - before.responses == 6);
+  CHECK(after.compressedResponses - before.compressedResponses == 6);
+  CHECK(after.wireBytes - before.wireBytes == wire);
+  CHECK(after.decodedBytes - before.decodedBytes == 6 * body.size());
+}
+
+TEST_CASE("transport: stream compressed terpotong (tanpa Z_STREAM_END) gagal") {
+  const std::string body = LargeBody();
+  const size_t full = Compress(body, "gzip").size();
+  HttpResponse res;
+  for (size_t limit : { full - 8, full / 2, size_t(20) }) {
+    TestServer().setHandler([&](const ServedRequest&) {
+      ServedResponse r;
+      r.body = body;
+      r.encoding = "gzip";
+      r.wireLimit = limit;      // Content-Length ikut potongan: framing HTTP-nya sendiri valid
+      return r;
+    });
+    CHECK(!Get("/truncated", res));
+    CHECK(res.status == 0 && res.body.empty());
+  }
+}
+
+TEST_CASE("transport: koneksi putus di tengah body gagal, status 0") {
+  TestServer().setHandler([](const ServedRequest&) {
+    ServedResponse r;
+    r.body = std::string(100000, 'x');
+    r.dropMidBody = true;
+    return r;
+  });
+  HttpResponse res;
+  CHECK(!Get("/drop", res));
+  CHECK(res.status == 0 && res.body.empty());
+
+  TestServer().setHandler([](const ServedRequest&) {
+    ServedResponse r;
+    r.body = std::string(100000, 'x');
+    r.encoding = "gzip";
+    r.chunked = true;
+    r.dropMidBody = true;
+    return r;
+  });
+  CHECK(!Get("/drop-chunked", res));
+}
+
+TEST_CASE("transport: keep-alive memakai ulang satu koneksi") {
+  TestServer().setHandler([](const ServedRequest&) {
+    ServedResponse r;
+    r.body = "{\"ok\":true}";
+    return r;
+  });
+  HttpResponse res;
+  REQUIRE(Get("/warm", res));     // Pastikan ada socket idle di pool
+  TestServer().resetCounters();
+  for (int i = 0; i < 50; i++) {
+    REQUIRE(Get("/keepalive", res));
+    CHECK(res.body == "{\"ok\":true}");
+  }
+  CHECK(TestServer().requests() == 50);
+  CHECK(TestServer().connections() == 0);
+
+  // Server menutup: request berikutnya buka koneksi baru
+  TestServer().setHandler([](const ServedRequest&) {
+    ServedResponse r;
+    r.body = "bye";
+    r.closeAfter = true;
+    return r;
+  });
+  REQUIRE(Get("/close", res));     // Socket idle dari atas dipakai sekali lagi lalu ditutup
+  TestServer().resetCounters();
+  for (int i = 0; i < 5; i++) REQUIRE(Get("/close", res));
+  CHECK(TestServer().connections() == 5);
+}
+
+TEST_CASE("transport: trailer chunked dibuang, socket keep-alive tetap bersih") {
+  TestServer().setHandler([](const ServedRequest& req) {
+    ServedResponse r;
+    r.body = "{\"path\":\"" + req.path + "\"}";
+    r.chunked = true;
+    r.trailers = "X-Checksum: 1234\r\nX-Served-By: local\r\n";
+    return r;
+  });
+  HttpResponse res;
+  REQUIRE(Get("/warm", res));
+  TestServer().resetCounters();
+  for (int i = 0; i < 20; i++) {
+    const std::string path = "/trailer/" + std::to_string(i);
+    REQUIRE(Get(path, res));
+    CHECK(res.status == 200 && res.body == "{\"path\":\"" + path + "\"}");
+  }
+  CHECK(TestServer().requests() == 20);
+  CHECK(TestServer().connections() == 0);
+}
+
+TEST_CASE("transport: socket idle basi diganti sebelum kirim, gagal setelah kirim tidak diulang") {
+  // Server menutup koneksi keep-alive diam-diam: socket idle terdeteksi sebelum dipakai
+  TestServer().setHandler([](const ServedRequest&) {
+    ServedResponse r;
+    r.body = "{\"ok\":true}";
+    r.closeSilently = true;
+    return r;
+  });
+  HttpResponse res;
+  REQUIRE(Get("/idle-timeout", res));
+  TestServer().resetCounters();
+  for (int i = 0; i < 5; i++) {
+    std::this_thread::sleep_for(std::chrono::milliseconds(20));    // FIN sampai ke client
+    REQUIRE(Get("/idle-timeout", res));
+    CHECK(res.body == "{\"ok\":true}");
+  }
+  CHECK(TestServer().requests() == 5 && TestServer().connections() == 5);
+
+  // Request sudah terkirim lewat socket reuse lalu gagal: tidak dikirim ulang diam-diam
+  TestServer().setHandler([](const ServedRequest&) {
+    ServedResponse r;
+    r.body = "{\"ok\":true}";
+    return r;
+  });
+  std::this_thread::sleep_for(std::chrono::milliseconds(20));
+  REQUIRE(Get("/warm", res));
+  TestServer().setHandler([](const ServedRequest&) {
+    ServedResponse r;
+    r.body = std::string(100000, 'x');
+    r.dropMidBody = true;
+    return r;
+  });
+  TestServer().resetCounters();
+  CHECK(!Get("/drop", res));
+  CHECK(TestServer().requests() == 1 && TestServer().connections() == 0);
+}
+
+TEST_CASE("transport: status error, Retry-After dan header Accept") {
+  std::string seenAccept;
+  TestServer().setHandler([&](const ServedRequest& req) {
+    seenAccept = req.accept;
+    ServedResponse r;
+    r.status = 429;
+    r.retryAfterSec = 3;
+    r.body = "slow down";
+    return r;
+  });
+  HttpResponse res;
+  REQUIRE(Get("/busy", res, "application/x-protobuf"));
+  CHECK(res.status == 429 && res.retryAfterSec == 3);
+  CHECK(res.body == "slow down");
+  CHECK(seenAccept == "application/x-protobuf");
+
+  REQUIRE(Get("/busy", res));
+  CHECK(seenAccept.empty());
+
+  CHECK(!DefaultHttpTransport().get("https://127.0.0.1/x", 1000, res));   // POSIX backend: http saja
+  CHECK(!DefaultHttpTransport().get("http://127.0.0.1:1/x", 1000, res));  // Connect ditolak
+  CHECK(res.status == 0);
+}
@@ -0,0 +1,65 @@
+#include "check.h"
+#include "test_env.h"
+#include <cstdlib>
+#include <cstring>
+#include <exception>
+#include <filesystem>
+#include <unistd.h>
+
+static LocalServer* g_server = nullptr;
+
+LocalServer& TestServer() {
+  return *g_server;
+}
+
+const std::string& TestTempDir() {
+  static const std::string dir = [] {
+    auto path = std::filesystem::temp_directory_path() / ("valkyrie_tests_" + std::to_string(getpid()));
+    std::filesystem::create_directories(path);
+    return path.string();
+  }();
+  return dir;
+}
+
+int main(int argc, char** argv) {
+  LocalServer server([](const ServedRequest&) { return ServedResponse(); });
+  g_server = &server;
+
+  // Config singleton: set sebelum pemakaian pertama. Retry/breaker dibuat kecil
+  // supaya skenario server rusak selesai dalam hitungan ratus ms.
+  setenv("PLUGIN_HOST", server.url().c_str(), 1);
+  setenv("PLUGIN_USERNAME", "test", 1);
+  setenv("PLUGIN_SOCKET", "ws://127.0.0.1:1", 1);
+  setenv("PLUGIN_HTTP_RETRIES", "2", 1);
+  setenv("PLUGIN_HTTP_DEADLINE_MS", "5000", 1);
+  setenv("PLUGIN_BREAKER_THRESHOLD", "3", 1);
+  setenv("PLUGIN_BREAKER_COOLDOWN_MS", "300", 1);
+  for (const char* key : { "PLUGIN_RATE_HISTORICAL", "PLUGIN_RATE_OWNERSHIP", "PLUGIN_RATE_FINANCIALS", "PLUGIN_RATE_RITELFLOW" }) {
+    setenv(key, "0,1,2000", 1);    // 0 = tanpa batas
+  }
+
+  const char* filter = argc > 1 ? argv[1] : nullptr;
+  int run = 0;
+  int failedTests = 0;
+  for (const auto& test : check::registry()) {
+    if (filter && !strstr(test.name, filter)) continue;
+    const int before = check::failures();
+    try {
+      test.fn();
+    } catch (const check::RequireFailed&) {
+      // Sudah dicatat oleh REQUIRE
+    } catch (const std::exception& e) {
+      fprintf(stderr, "  exception: %s\n", e.what());
+      check::failures()++;
+    }
+    const bool ok = check::failures() == before;
+    printf("[%s] %s\n", ok ? " OK " : "FAIL", test.name);
+    run++;
+    if (!ok) failedTests++;
+  }
+
+  std::error_code ec;
+  std::filesystem::remove_all(TestTempDir(), ec);
+  printf("%d test(s), %d failed\n", run, failedTests);
+  return failedTests == 0 ? 0 : 1;
+}
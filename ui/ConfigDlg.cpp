@@ -2,6 +2,7 @@
 #include "resource.h"
 #include "api_client.h"
 #include "config.h"
+#include "refresh_notifier.h"
 #include <string>
 #include <vector>
 #include <map>
@@ -296,9 +297,7 @@ void CConfigureDlg::OnRetrieveClicked(HWND hDlg) {
   EnableWindow(hBtn, TRUE);
   m_fetchedSymbolList.clear();
 
-  if (g_hAmiBrokerWnd) {
-    PostMessage(g_hAmiBrokerWnd, WM_USER_STREAMING_UPDATE, 0, 0);
-  }
+  RefreshNotifier::instance().signal();   // Daftar simbol berubah: refresh semua
 }
 
 INT_PTR CALLBACK CConfigureDlg::DialogProc(HWND hDlg, UINT message, WPARAM wParam, LPARAM lParam) {